@@ -0,0 +1,347 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+namespace overflow_policies
+{
+    // `defining_a_template_specialization_2::abs<int>` throws on INT_MIN. Here the reaction to overflow is a
+    // template parameter instead, and works for every integral width:
+    //
+    //   abs<throw_on_overflow>(x)  throws std::domain_error (the default for both forms, same as the specialization)
+    //   abs<saturate>(x)           abs(INT_MIN) == INT_MAX
+    //   abs<wrap>(x)               abs(INT_MIN) == INT_MIN
+    //   abs<expected>(x)           returns an expected value with std::errc::value_too_large
+    //   abs(in, out, collect{bits}) batch only: records one overflow bit per element
+    //
+    // Every policy computes the wrapped result and the overflow flag without branching; only the final step
+    // (throwing, returning an error) looks at the flag.
+
+#if defined(__cpp_lib_expected)
+    template <typename T>
+    using expected_abs = std::expected<T, std::errc>;
+
+    template <typename T>
+    constexpr expected_abs<T>
+    make_error(std::errc e)
+    {
+        return std::unexpected(e);
+    }
+#else
+    // Minimal stand-in for std::expected<T, std::errc> until the build moves to C++23.
+    template <typename T>
+    class expected_abs
+    {
+      public:
+        constexpr expected_abs(T value) : value_(value), error_()
+        {
+        }
+
+        constexpr explicit expected_abs(std::errc e, std::in_place_t) : value_(), error_(e)
+        {
+        }
+
+        constexpr bool
+        has_value() const
+        {
+            return error_ == std::errc();
+        }
+
+        constexpr explicit
+        operator bool() const
+        {
+            return has_value();
+        }
+
+        constexpr T
+        value() const
+        {
+            if (!has_value())
+            {
+                throw std::domain_error("abs: bad expected access");
+            }
+            return value_;
+        }
+
+        constexpr T
+        operator*() const
+        {
+            return value_;
+        }
+
+        constexpr std::errc
+        error() const
+        {
+            return error_;
+        }
+
+      private:
+        T         value_;
+        std::errc error_;
+    };
+
+    template <typename T>
+    constexpr expected_abs<T>
+    make_error(std::errc e)
+    {
+        return expected_abs<T>(e, std::in_place);
+    }
+#endif
+
+    namespace detail
+    {
+        template <std::integral T>
+        constexpr bool
+        overflows(T x)
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                return x == std::numeric_limits<T>::min();
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        // abs(x) = (x ^ m) - m with m = all ones for negative x; computed unsigned, so the minimum value wraps.
+        template <std::integral T>
+        constexpr T
+        wrap_abs(T x)
+        {
+            if constexpr (std::is_signed_v<T>)
+            {
+                using U = std::make_unsigned_t<T>;
+                U m     = static_cast<U>(x < 0 ? ~U(0) : U(0));
+                return static_cast<T>((static_cast<U>(x) ^ m) - m);
+            }
+            else
+            {
+                return x;
+            }
+        }
+
+    } // namespace detail
+
+    // Policy interface:
+    //   lane(wrapped, overflow)    branch-free value stored for one element
+    //   finish(value, overflow)    scalar result (may throw / wrap the value into an error type)
+    //   finish_batch(any_overflow) called once after a whole batch
+    //   batchable                  whether the batch form accepts the policy
+
+    struct throw_on_overflow
+    {
+        template <typename T>
+        using result = T;
+
+        static constexpr bool batchable = true;
+
+        template <typename T>
+        static constexpr T
+        lane(T wrapped, bool)
+        {
+            return wrapped;
+        }
+
+        template <typename T>
+        static constexpr T
+        finish(T value, bool overflow)
+        {
+            if (overflow)
+            {
+                throw std::domain_error("oops");
+            }
+            return value;
+        }
+
+        static constexpr void
+        finish_batch(bool any_overflow)
+        {
+            if (any_overflow)
+            {
+                throw std::domain_error("oops");
+            }
+        }
+    };
+
+    struct saturate
+    {
+        template <typename T>
+        using result = T;
+
+        static constexpr bool batchable = true;
+
+        // select, not a branch: compiles to cmov / a vector blend
+        template <typename T>
+        static constexpr T
+        lane(T wrapped, bool overflow)
+        {
+            return overflow ? std::numeric_limits<T>::max() : wrapped;
+        }
+
+        template <typename T>
+        static constexpr T
+        finish(T value, bool)
+        {
+            return value;
+        }
+
+        static constexpr void
+        finish_batch(bool)
+        {
+        }
+    };
+
+    struct wrap
+    {
+        template <typename T>
+        using result = T;
+
+        static constexpr bool batchable = true;
+
+        template <typename T>
+        static constexpr T
+        lane(T wrapped, bool)
+        {
+            return wrapped;
+        }
+
+        template <typename T>
+        static constexpr T
+        finish(T value, bool)
+        {
+            return value;
+        }
+
+        static constexpr void
+        finish_batch(bool)
+        {
+        }
+    };
+
+    struct expected
+    {
+        template <typename T>
+        using result = expected_abs<T>;
+
+        // one expected<T> per element would put the branch back into the loop; use `collect` for batches
+        static constexpr bool batchable = false;
+
+        template <typename T>
+        static constexpr T
+        lane(T wrapped, bool)
+        {
+            return wrapped;
+        }
+
+        template <typename T>
+        static constexpr result<T>
+        finish(T value, bool overflow)
+        {
+            if (overflow)
+            {
+                return make_error<T>(std::errc::value_too_large);
+            }
+            return value;
+        }
+    };
+
+    // Batch only: wraps like `wrap` and sets bit (i % 64) of bits[i / 64] for every element i that overflowed.
+    struct collect
+    {
+        std::span<std::uint64_t> bits;
+
+        static constexpr bool batchable = true;
+
+        template <typename T>
+        static constexpr T
+        lane(T wrapped, bool)
+        {
+            return wrapped;
+        }
+
+        static constexpr void
+        finish_batch(bool)
+        {
+        }
+    };
+
+    // scalar
+    // NOTE: Policy comes first, so `abs<saturate>(x)` still deduces T.
+    template <typename Policy = throw_on_overflow, std::integral T>
+    constexpr typename Policy::template result<T>
+    abs(T x)
+    {
+        bool overflow = detail::overflows(x);
+        return Policy::finish(Policy::lane(detail::wrap_abs(x), overflow), overflow);
+    }
+
+    // batch: no branch inside the loop, one aggregated overflow flag at the end (also the return value)
+    // NOTE: Same default as the scalar form: throws once after the whole batch, so `out` is fully written.
+    template <typename Policy = throw_on_overflow, std::integral T>
+    bool
+    abs(std::type_identity_t<std::span<const T>> in, std::span<T> out, Policy policy = {})
+    {
+        static_assert(Policy::batchable, "this overflow policy has no batch form");
+
+        if (out.size() < in.size())
+        {
+            throw std::length_error("abs: output range is smaller than input range");
+        }
+
+        const std::size_t n = in.size();
+        bool              any_overflow{};
+
+        if constexpr (std::is_same_v<Policy, collect>)
+        {
+            if (policy.bits.size() < (n + 63) / 64)
+            {
+                throw std::length_error("abs: error bitmask is too small");
+            }
+            for (std::size_t block = 0; block * 64 < n; block++)
+            {
+                std::size_t   first = block * 64;
+                std::size_t   last  = std::min(n, first + 64);
+                std::uint64_t word{};
+                for (std::size_t i = first; i < last; i++)
+                {
+                    bool overflow = detail::overflows(in[i]);
+                    out[i]        = Policy::lane(detail::wrap_abs(in[i]), overflow);
+                    word |= std::uint64_t(overflow) << (i - first);
+                }
+                policy.bits[block] = word;
+                any_overflow |= word != 0;
+            }
+        }
+        else
+        {
+            (void)policy;
+            // accumulate in T rather than bool, so the loop vectorizes
+            std::make_unsigned_t<T> acc{};
+            for (std::size_t i = 0; i < n; i++)
+            {
+                bool overflow = detail::overflows(in[i]);
+                out[i]        = Policy::lane(detail::wrap_abs(in[i]), overflow);
+                acc |= static_cast<std::make_unsigned_t<T>>(overflow);
+            }
+            any_overflow = acc != 0;
+        }
+
+        Policy::finish_batch(any_overflow);
+        return any_overflow;
+    }
+
+} // namespace overflow_policies
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <type_traits>
+
+namespace good_tag_dispatch
+{
+    // tree_iterator and tree: see tree.hpp (B+ tree, tree_iterator::supports_plus is std::false_type,
+    // tree_iterator::supports_logarithmic_jump is std::true_type)
+
+    template <typename Element>
+    struct vector_iterator
+    {
+        vector_iterator &operator++();
+        vector_iterator  operator+();
+        using supports_plus = std::true_type;
+    };
+
+    template <typename Element>
+    struct vector
+    {
+        using iterator = vector_iterator<Element>;
+    };
+
+    template <typename Iter>
+    Iter
+    advance_impl(Iter begin, int n, std::false_type)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            ++begin;
+        }
+        return begin;
+    }
+
+    template <typename Iter>
+    Iter
+    advance_impl(Iter begin, int n, std::true_type)
+    {
+        return begin + n;
+    }
+
+    // A third tag: no `+`, but the iterator can skip n elements in O(log n) (e.g. tree_iterator::jump).
+    struct logarithmic_jump_tag
+    {
+    };
+
+    template <typename Iter>
+    Iter
+    advance_impl(Iter begin, int n, logarithmic_jump_tag)
+    {
+        return begin.jump(n);
+    }
+
+    // Iterators that don't mention supports_logarithmic_jump at all (like vector_iterator) get std::false_type.
+    template <typename Iter, typename = void>
+    struct supports_logarithmic_jump : std::false_type
+    {
+    };
+
+    template <typename Iter>
+    struct supports_logarithmic_jump<Iter, std::void_t<typename Iter::supports_logarithmic_jump>>
+        : Iter::supports_logarithmic_jump
+    {
+    };
+
+    // `+` wins, then the logarithmic jump, then n times ++
+    template <typename Iter>
+    using advance_tag = std::conditional_t<!Iter::supports_plus::value && supports_logarithmic_jump<Iter>::value,
+                                           logarithmic_jump_tag, typename Iter::supports_plus>;
+
+    // NOTE: returns `Iter` rather than `auto`: an `extern template` declaration does not stop the instantiation of a
+    // function with a deduced return type (see instantiations.hpp).
+    template <typename Iter>
+    Iter
+    advance(Iter begin, int n)
+    {
+        // NOTE: `typename` is not strictly necessary in C++20.
+        // NOTE: We instantiate a value of the tag type (you can use `()` or `{}`). See below.
+        return advance_impl(begin, n, advance_tag<Iter>());
+    }
+
+} // namespace good_tag_dispatch
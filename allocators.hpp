@@ -0,0 +1,353 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+
+namespace allocators
+{
+    // Allocation policies for alias_templates::myvec<T, Policy>:
+    //
+    //   policy::heap    std::allocator<T> (operator new, i.e. malloc); myvec<T> is still std::vector<T>
+    //   policy::arena   arena_allocator<T>: bump pointer into an `arena`, deallocate is (almost) free, and
+    //                   arena::reset() releases everything allocated from it at once
+    //   policy::pool    pool_allocator<T>: per size class freelists in a `pool`, for churn of similar sizes
+    //   policy::pmr     std::pmr::polymorphic_allocator<T>, with any std::pmr::memory_resource
+    //
+    // arena and pool are not thread-safe, and the allocators only hold a pointer to them: the resource must outlive
+    // every container using it. An arena-backed container must also not be used (or destroyed) after a reset() of its
+    // arena.
+
+    // Monotonic bump-pointer resource. Memory comes from chunks that double in size; reset() keeps the largest chunk
+    // for the next round and frees the others.
+    class arena
+    {
+      public:
+        explicit arena(std::size_t initial_size = 4096) : next_size_(initial_size)
+        {
+        }
+
+        arena(const arena &) = delete;
+        arena &
+        operator=(const arena &) = delete;
+
+        ~arena()
+        {
+            release(nullptr);
+        }
+
+        void *
+        allocate(std::size_t bytes, std::size_t alignment)
+        {
+            std::uintptr_t p = (cur_ + alignment - 1) & ~(alignment - 1);
+            if (p + bytes > end_) [[unlikely]]
+            {
+                grow(bytes + alignment);
+                p = (cur_ + alignment - 1) & ~(alignment - 1);
+            }
+            cur_ = p + bytes;
+            return reinterpret_cast<void *>(p);
+        }
+
+        // Only the most recent allocation is given back (which covers a vector that grows and then shrinks or is
+        // destroyed right away); anything else waits for reset().
+        void
+        deallocate(void *p, std::size_t bytes) noexcept
+        {
+            if (reinterpret_cast<std::uintptr_t>(p) + bytes == cur_)
+            {
+                cur_ = reinterpret_cast<std::uintptr_t>(p);
+            }
+        }
+
+        // Releases everything allocated so far.
+        void
+        reset() noexcept
+        {
+            chunk *largest = chunks_;
+            for (chunk *c = chunks_; c; c = c->next)
+            {
+                if (c->size > largest->size)
+                {
+                    largest = c;
+                }
+            }
+            release(largest);
+            if (largest)
+            {
+                largest->next = nullptr;
+                chunks_       = largest;
+                cur_          = reinterpret_cast<std::uintptr_t>(largest + 1);
+                end_          = reinterpret_cast<std::uintptr_t>(largest) + largest->size;
+            }
+        }
+
+      private:
+        struct alignas(std::max_align_t) chunk
+        {
+            chunk      *next;
+            std::size_t size; // including this header
+        };
+
+        void
+        grow(std::size_t at_least)
+        {
+            std::size_t size = std::max(next_size_, std::bit_ceil(at_least + sizeof(chunk)));
+            next_size_       = size * 2;
+            chunk *c         = new (::operator new(size)) chunk{chunks_, size};
+            chunks_          = c;
+            cur_             = reinterpret_cast<std::uintptr_t>(c + 1);
+            end_             = reinterpret_cast<std::uintptr_t>(c) + size;
+        }
+
+        void
+        release(chunk *keep) noexcept
+        {
+            for (chunk *c = chunks_; c;)
+            {
+                chunk *next = c->next;
+                if (c != keep)
+                {
+                    ::operator delete(c);
+                }
+                c = next;
+            }
+            chunks_ = nullptr;
+            cur_ = end_ = 0;
+        }
+
+        chunk         *chunks_ = nullptr;
+        std::uintptr_t cur_    = 0;
+        std::uintptr_t end_    = 0;
+        std::size_t    next_size_;
+    };
+
+    // Size-class pool: blocks of 16, 32, ..., 4096 bytes, each class with its own freelist, carved from 64 KiB
+    // chunks. Larger or over-aligned requests go to operator new. Memory returns to the system in the destructor.
+    class pool
+    {
+      public:
+        static constexpr std::size_t min_block = 16;
+        static constexpr std::size_t max_block = 4096;
+        static constexpr std::size_t classes   = 9; // log2(max_block / min_block) + 1
+
+        pool() = default;
+
+        pool(const pool &) = delete;
+        pool &
+        operator=(const pool &) = delete;
+
+        ~pool()
+        {
+            for (chunk *c = chunks_; c;)
+            {
+                chunk *next = c->next;
+                ::operator delete(c);
+                c = next;
+            }
+        }
+
+        void *
+        allocate(std::size_t bytes, std::size_t alignment)
+        {
+            if (bytes > max_block || alignment > alignof(std::max_align_t)) [[unlikely]]
+            {
+                return ::operator new(bytes, std::align_val_t(alignment));
+            }
+            std::size_t k = size_class(bytes);
+            if (block *b = free_[k])
+            {
+                free_[k] = b->next;
+                return b;
+            }
+            return carve(min_block << k);
+        }
+
+        void
+        deallocate(void *p, std::size_t bytes, std::size_t alignment) noexcept
+        {
+            if (bytes > max_block || alignment > alignof(std::max_align_t)) [[unlikely]]
+            {
+                ::operator delete(p, std::align_val_t(alignment));
+                return;
+            }
+            std::size_t k = size_class(bytes);
+            free_[k]      = new (p) block{free_[k]};
+        }
+
+      private:
+        struct block
+        {
+            block *next;
+        };
+
+        struct alignas(std::max_align_t) chunk
+        {
+            chunk *next;
+        };
+
+        static constexpr std::size_t chunk_size = 64 * 1024;
+
+        static std::size_t
+        size_class(std::size_t bytes)
+        {
+            // 0..16 -> 0, 17..32 -> 1, ...
+            return std::bit_width((std::max(bytes, std::size_t(1)) - 1) | (min_block - 1)) -
+                   std::bit_width(min_block - 1);
+        }
+
+        void *
+        carve(std::size_t size)
+        {
+            if (cur_ + size > end_)
+            {
+                chunk *c = new (::operator new(chunk_size)) chunk{chunks_};
+                chunks_  = c;
+                cur_     = reinterpret_cast<std::uintptr_t>(c + 1);
+                end_     = reinterpret_cast<std::uintptr_t>(c) + chunk_size;
+            }
+            void *p = reinterpret_cast<void *>(cur_);
+            cur_ += size;
+            return p;
+        }
+
+        block         *free_[classes] = {};
+        chunk         *chunks_        = nullptr;
+        std::uintptr_t cur_           = 0;
+        std::uintptr_t end_           = 0;
+    };
+
+    template <typename T>
+    class arena_allocator
+    {
+      public:
+        using value_type = T;
+
+        // containers that are copied or moved keep allocating from the same arena
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+
+        arena_allocator(arena &a) noexcept : arena_(&a)
+        {
+        }
+
+        template <typename U>
+        arena_allocator(const arena_allocator<U> &other) noexcept : arena_(other.resource())
+        {
+        }
+
+        T *
+        allocate(std::size_t n)
+        {
+            return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void
+        deallocate(T *p, std::size_t n) noexcept
+        {
+            arena_->deallocate(p, n * sizeof(T));
+        }
+
+        arena *
+        resource() const noexcept
+        {
+            return arena_;
+        }
+
+        template <typename U>
+        bool
+        operator==(const arena_allocator<U> &other) const noexcept
+        {
+            return arena_ == other.resource();
+        }
+
+      private:
+        arena *arena_;
+    };
+
+    template <typename T>
+    class pool_allocator
+    {
+      public:
+        using value_type = T;
+
+        using propagate_on_container_copy_assignment = std::true_type;
+        using propagate_on_container_move_assignment = std::true_type;
+        using propagate_on_container_swap            = std::true_type;
+
+        pool_allocator(pool &p) noexcept : pool_(&p)
+        {
+        }
+
+        template <typename U>
+        pool_allocator(const pool_allocator<U> &other) noexcept : pool_(other.resource())
+        {
+        }
+
+        T *
+        allocate(std::size_t n)
+        {
+            return static_cast<T *>(pool_->allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void
+        deallocate(T *p, std::size_t n) noexcept
+        {
+            pool_->deallocate(p, n * sizeof(T), alignof(T));
+        }
+
+        pool *
+        resource() const noexcept
+        {
+            return pool_;
+        }
+
+        template <typename U>
+        bool
+        operator==(const pool_allocator<U> &other) const noexcept
+        {
+            return pool_ == other.resource();
+        }
+
+      private:
+        pool *pool_;
+    };
+
+    namespace policy
+    {
+        struct heap
+        {
+            template <typename T>
+            using allocator = std::allocator<T>;
+        };
+
+        struct arena
+        {
+            template <typename T>
+            using allocator = arena_allocator<T>;
+        };
+
+        struct pool
+        {
+            template <typename T>
+            using allocator = pool_allocator<T>;
+        };
+
+        struct pmr
+        {
+            template <typename T>
+            using allocator = std::pmr::polymorphic_allocator<T>;
+        };
+
+    } // namespace policy
+
+    template <typename Policy, typename T>
+    using allocator_t = typename Policy::template allocator<T>;
+
+} // namespace allocators
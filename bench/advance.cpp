@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "advance.hpp"
+#include "mylist.hpp"
+#include "suites.hpp"
+#include "tree.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr int size = 1 << 16;
+
+        // vector_iterator from advance.hpp is declaration-only; this is a real pointer iterator with `+`
+        struct pointer_iterator
+        {
+            const int *p;
+
+            using supports_plus = std::true_type;
+
+            pointer_iterator &
+            operator++()
+            {
+                ++p;
+                return *this;
+            }
+
+            pointer_iterator
+            operator+(int n) const
+            {
+                return {p + n};
+            }
+
+            const int &
+            operator*() const
+            {
+                return *p;
+            }
+        };
+
+        // random distances, so neither the branch predictor nor the optimizer sees a constant
+        std::vector<int>
+        distances(int max)
+        {
+            std::mt19937     gen(7);
+            std::vector<int> v(1024);
+            for (int &d : v)
+            {
+                d = static_cast<int>(gen() % static_cast<unsigned>(max));
+            }
+            return v;
+        }
+
+        // one operation = one advance() from begin by a random distance < max
+        template <typename Begin, typename Advance>
+        void
+        add_case(registry &r, std::string name, Begin begin, Advance adv, int max)
+        {
+            r.add(std::move(name), [begin, adv, d = distances(max)](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; it++)
+                {
+                    auto pos = adv(begin(), d[it % d.size()]);
+                    do_not_optimize(*pos);
+                }
+            });
+        }
+
+    } // namespace
+
+    void
+    add_advance(registry &r)
+    {
+        using namespace good_tag_dispatch;
+
+        static const std::vector<int> values = [] {
+            std::vector<int> v(size);
+            for (int i = 0; i < size; i++)
+            {
+                v[i] = i;
+            }
+            return v;
+        }();
+        static const tree<int> t = [] {
+            tree<int> t;
+            for (int x : values)
+            {
+                t.insert(x);
+            }
+            return t;
+        }();
+        static const class_templates::mylist<int> l = [] {
+            class_templates::mylist<int> l;
+            for (int x : values)
+            {
+                l.push_back(x);
+            }
+            return l;
+        }();
+
+        auto dispatched = [](auto begin, int n) { return advance(begin, n); };
+        auto increments = [](auto begin, int n) { return advance_impl(begin, n, std::false_type{}); };
+
+        // the three tags of advance(), short and long distances
+        for (int max : {64, size})
+        {
+            std::string suffix = max == size ? "/far" : "/near";
+            add_case(
+                r, "advance/plus/pointer" + suffix, [] { return pointer_iterator{values.data()}; }, dispatched, max);
+            add_case(
+                r, "advance/jump/tree" + suffix, [] { return t.begin(); }, dispatched, max);
+            add_case(
+                r, "advance/increment/tree" + suffix, [] { return t.begin(); }, increments, max);
+            add_case(
+                r, "advance/increment/mylist" + suffix, [] { return l.begin(); }, increments, max);
+        }
+    }
+
+} // namespace bench
@@ -0,0 +1,116 @@
+#include <array>
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <vector>
+
+#include "allocators.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr std::size_t vectors = 16;
+
+        // lengths of the vectors built by one request, 1..256 (fixed LCG, same for every allocator)
+        constexpr std::array<std::size_t, vectors> lengths = [] {
+            std::array<std::size_t, vectors> a{};
+            std::size_t                      x = 12345;
+            for (auto &n : a)
+            {
+                x = x * 6364136223846793005 + 1442695040888963407;
+                n = (x >> 33) % 256 + 1;
+            }
+            return a;
+        }();
+
+        constexpr std::size_t elements = [] {
+            std::size_t sum = 0;
+            for (std::size_t n : lengths)
+            {
+                sum += n;
+            }
+            return sum;
+        }();
+
+        // One request: build `vectors` vectors by push_back (so every one reallocates as it grows) while the
+        // previous ones are still alive, read them, destroy them all.
+        template <typename Vector, typename Make>
+        void
+        request(Make make)
+        {
+            std::array<std::optional<Vector>, vectors> live;
+            int                                        sum = 0;
+            for (std::size_t v = 0; v < vectors; v++)
+            {
+                live[v].emplace(make());
+                for (std::size_t i = 0; i < lengths[v]; i++)
+                {
+                    live[v]->push_back(int(i));
+                }
+                sum += live[v]->back();
+            }
+            do_not_optimize(sum);
+            for (auto &v : live)
+            {
+                v.reset();
+            }
+        }
+
+        // one operation = one request; items = elements pushed
+        template <typename Body>
+        void
+        add_requests(registry &r, std::string name, Body body)
+        {
+            r.add(
+                std::move(name),
+                [body](std::size_t iterations) mutable {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        body();
+                    }
+                },
+                elements);
+        }
+
+    } // namespace
+
+    void
+    add_allocators(registry &r)
+    {
+        using allocators::allocator_t;
+        namespace policy = allocators::policy;
+
+        add_requests(r, "allocators/request/heap", [] {
+            request<std::vector<int, allocator_t<policy::heap, int>>>([] { return std::vector<int>(); });
+        });
+
+        add_requests(r, "allocators/request/arena", [] {
+            using vector = std::vector<int, allocator_t<policy::arena, int>>;
+            static allocators::arena arena;
+            request<vector>([] { return vector(arena); });
+            arena.reset();
+        });
+
+        add_requests(r, "allocators/request/pool", [] {
+            using vector = std::vector<int, allocator_t<policy::pool, int>>;
+            static allocators::pool pool;
+            request<vector>([] { return vector(pool); });
+        });
+
+        add_requests(r, "allocators/request/pmr_unsynchronized_pool", [] {
+            using vector = std::vector<int, allocator_t<policy::pmr, int>>;
+            static std::pmr::unsynchronized_pool_resource pool;
+            request<vector>([] { return vector(&pool); });
+        });
+
+        add_requests(r, "allocators/request/pmr_monotonic", [] {
+            using vector = std::vector<int, allocator_t<policy::pmr, int>>;
+            static std::pmr::monotonic_buffer_resource monotonic;
+            request<vector>([] { return vector(&monotonic); });
+            monotonic.release();
+        });
+    }
+
+} // namespace bench
@@ -0,0 +1,112 @@
+#include <array>
+#include <cstddef>
+#include <functional>
+
+#include "callables.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr std::size_t calls = 1024;
+
+        int
+        plain(int x)
+        {
+            return x + 1;
+        }
+
+        // one operation = `calls` calls through `f`; do_not_optimize(f) makes the compiler reload the wrapper's
+        // state every time, so it cannot see through the type erasure and inline the lambda
+        template <typename Wrapper>
+        void
+        add_call(registry &r, std::string name, Wrapper f)
+        {
+            r.add(
+                std::move(name),
+                [f](std::size_t iterations) mutable {
+                    int x = 0;
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        for (std::size_t i = 0; i < calls; i++)
+                        {
+                            do_not_optimize(f);
+                            x = f(x);
+                        }
+                    }
+                    do_not_optimize(x);
+                },
+                calls);
+        }
+
+        // one operation = construct (and destroy) a wrapper from a lambda with `Captured` bytes of captures
+        template <template <typename> class Make, std::size_t Captured>
+        void
+        add_construct(registry &r, std::string name)
+        {
+            r.add(std::move(name), [](std::size_t iterations) {
+                std::array<char, Captured> captured{};
+                for (std::size_t it = 0; it < iterations; it++)
+                {
+                    do_not_optimize(captured);
+                    auto lambda = [captured](int x) { return x + captured[0]; };
+                    auto f      = Make<decltype(lambda)>::make(lambda);
+                    do_not_optimize(f);
+                }
+            });
+        }
+
+        template <typename L>
+        struct make_std_function
+        {
+            static std::function<int(int)>
+            make(L &l)
+            {
+                return l;
+            }
+        };
+
+        template <typename L>
+        struct make_function_ref
+        {
+            static callables::function_ref<int(int)>
+            make(L &l)
+            {
+                return l;
+            }
+        };
+
+        template <typename L>
+        struct make_inplace_function
+        {
+            static callables::inplace_function<int(int), 64>
+            make(L &l)
+            {
+                return l;
+            }
+        };
+
+    } // namespace
+
+    void
+    add_callables(registry &r)
+    {
+        // static: the function_ref below refers to it for as long as the benchmark runs
+        static const auto capture = [k = 1](int x) { return x + k; };
+
+        add_call(r, "callables/call/function_pointer", &plain);
+        add_call(r, "callables/call/std::function", std::function<int(int)>(capture));
+        add_call(r, "callables/call/function_ref", callables::function_ref<int(int)>(capture));
+        add_call(r, "callables/call/inplace_function", callables::inplace_function<int(int)>(capture));
+
+        // 8 bytes fit std::function's small buffer (16 bytes in libstdc++), 48 bytes don't
+        add_construct<make_std_function, 8>(r, "callables/construct/std::function/8B");
+        add_construct<make_std_function, 48>(r, "callables/construct/std::function/48B");
+        add_construct<make_function_ref, 8>(r, "callables/construct/function_ref/8B");
+        add_construct<make_function_ref, 48>(r, "callables/construct/function_ref/48B");
+        add_construct<make_inplace_function, 8>(r, "callables/construct/inplace_function/8B");
+        add_construct<make_inplace_function, 48>(r, "callables/construct/inplace_function/48B");
+    }
+
+} // namespace bench
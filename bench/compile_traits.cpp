@@ -0,0 +1,299 @@
+// Compile-time cost of the trait techniques of f.cpp.
+//
+// For every technique and every instantiation count this generates a translation unit that declares that many
+// distinct types and applies the trait to each of them. The TU is compiled a few times, and wall time and peak
+// memory (bench::run_process) are recorded. The per-instantiation cost is the least-squares slope over the counts,
+// minus the slope of a baseline TU that declares the same types without any trait.
+//
+//   compile_traits [--count=N] [--repetitions=N] [--json=FILE] [--workdir=DIR] [--keep] [-- CXX FLAGS...]
+//
+// Everything after `--` is the compiler command (default: c++ -std=c++20). Add e.g. -ftime-trace (clang) or
+// -ftime-report (GCC) there, together with --keep, for a breakdown of a single TU.
+//
+// The generated files go into a new directory DIR/compile_traits.XXXXXX (DIR defaults to the system temp
+// directory), which is removed at the end unless --keep is given. Nothing else in DIR is touched.
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harness.hpp"
+
+namespace
+{
+    struct technique
+    {
+        const char *name;
+        const char *definitions; // same as the namespace named in the comment, in f.cpp / is_pointer.hpp
+        const char *use;         // %1$d is the index of the type
+    };
+
+    const technique techniques[] = {
+        {"baseline", // types only, so the slopes below measure the traits alone
+         "",
+         "static_assert(sizeof(t%1$d) == 1);\n"},
+        {"class_value", // defining_a_template_specialization_1: is_void<T>::value
+         "template <typename T>\n"
+         "struct is_void\n"
+         "{\n"
+         "    static constexpr bool value = false;\n"
+         "};\n"
+         "template <>\n"
+         "struct is_void<void>\n"
+         "{\n"
+         "    static constexpr bool value = true;\n"
+         "};\n",
+         "static_assert(!is_void<t%1$d>::value);\n"},
+        {"variable_template", // variable_templates: is_void_v<T> on its own
+         "template <typename T>\n"
+         "constexpr bool is_void_v = false;\n"
+         "template <>\n"
+         "constexpr bool is_void_v<void> = true;\n",
+         "static_assert(!is_void_v<t%1$d>);\n"},
+        {"variable_over_class", // best_of_both_worlds: is_void_v<T> = is_void<T>::value
+         "template <typename T>\n"
+         "struct is_void\n"
+         "{\n"
+         "    static constexpr bool value = false;\n"
+         "};\n"
+         "template <typename T>\n"
+         "constexpr bool is_void_v = is_void<T>::value;\n",
+         "static_assert(!is_void_v<t%1$d>);\n"},
+        {"partial_spec_array", // partial_specialization_2: is_array<Tp[N]>
+         "template <typename T>\n"
+         "constexpr bool is_array = false;\n"
+         "template <typename Tp>\n"
+         "constexpr bool is_array<Tp[]> = true;\n"
+         "template <typename Tp, int N>\n"
+         "constexpr bool is_array<Tp[N]> = true;\n",
+         "static_assert(is_array<t%1$d[4]>);\n"},
+        {"helper_struct", // how_to_partially_specialize_a_function: is_pointer(T) -> is_pointer_impl<T>::_()
+         "template <typename T>\n"
+         "struct is_pointer_impl\n"
+         "{\n"
+         "    static bool _() { return false; }\n"
+         "};\n"
+         "template <typename T>\n"
+         "struct is_pointer_impl<T *>\n"
+         "{\n"
+         "    static bool _() { return true; }\n"
+         "};\n"
+         "template <typename T>\n"
+         "bool is_pointer(T) { return is_pointer_impl<T>::_(); }\n",
+         "bool b%1$d = is_pointer(static_cast<t%1$d *>(nullptr));\n"},
+    };
+
+    std::string
+    generate(const technique &t, int count)
+    {
+        std::string src = t.definitions;
+        char        line[160];
+        for (int i = 0; i < count; i++)
+        {
+            std::snprintf(line, sizeof line, "struct t%d\n{\n};\n", i);
+            src += line;
+            std::snprintf(line, sizeof line, t.use, i);
+            src += line;
+        }
+        return src;
+    }
+
+    // least-squares slope of y over x
+    double
+    slope(const std::vector<double> &x, const std::vector<double> &y)
+    {
+        double mx = 0, my = 0;
+        for (std::size_t i = 0; i < x.size(); i++)
+        {
+            mx += x[i] / x.size();
+            my += y[i] / y.size();
+        }
+        double num = 0, den = 0;
+        for (std::size_t i = 0; i < x.size(); i++)
+        {
+            num += (x[i] - mx) * (y[i] - my);
+            den += (x[i] - mx) * (x[i] - mx);
+        }
+        return den > 0 ? num / den : 0;
+    }
+
+    struct row
+    {
+        std::string name;
+        int         count;
+        double      ms;
+        double      rss_mb;
+    };
+
+    struct cost
+    {
+        std::string name;
+        double      us_per_instantiation;
+        double      kb_per_instantiation;
+    };
+
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    int                      count       = 4000;
+    int                      repetitions = 3;
+    bool                     keep        = false;
+    std::string              json_path;
+    std::filesystem::path    workdir = std::filesystem::temp_directory_path();
+    std::vector<std::string> cxx;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--")
+        {
+            cxx.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        else if (arg.substr(0, 8) == "--count=")
+        {
+            count = std::atoi(argv[i] + 8);
+        }
+        else if (arg.substr(0, 14) == "--repetitions=")
+        {
+            repetitions = std::atoi(argv[i] + 14);
+        }
+        else if (arg.substr(0, 7) == "--json=")
+        {
+            json_path = arg.substr(7);
+        }
+        else if (arg.substr(0, 10) == "--workdir=")
+        {
+            workdir = arg.substr(10);
+        }
+        else if (arg == "--keep")
+        {
+            keep = true;
+        }
+        else
+        {
+            std::cerr << "usage: compile_traits [--count=N] [--repetitions=N] [--json=FILE] [--workdir=DIR] [--keep]"
+                         " [-- CXX FLAGS...]\n";
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+    if (cxx.empty())
+    {
+        cxx = {"c++", "-std=c++20"};
+    }
+    if (count < 4 || repetitions < 1)
+    {
+        std::cerr << "compile_traits: --count must be at least 4 and --repetitions at least 1\n";
+        return 2;
+    }
+    workdir = bench::make_scratch_dir(workdir, "compile_traits"); // only this is removed at the end
+
+    const int        counts[] = {count / 4, count / 2, count};
+    std::vector<row> rows;
+    char             line[160];
+    std::snprintf(line, sizeof line, "%-22s %8s %10s %10s\n", "technique", "types", "ms", "max RSS MB");
+    std::cout << line;
+    for (const technique &t : techniques)
+    {
+        for (int n : counts)
+        {
+            std::filesystem::path source = workdir / (std::string(t.name) + "_" + std::to_string(n) + ".cpp");
+            std::ofstream(source) << generate(t, n);
+
+            std::vector<double> ms, rss;
+            for (int r = 0; r < repetitions; r++)
+            {
+                std::vector<std::string> args = cxx;
+                args.insert(args.end(), {"-c", source.string(), "-o", source.string() + ".o"});
+                bench::process_stats m = bench::run_process(args);
+                if (!m.ok)
+                {
+                    std::cerr << "compile_traits: compiling " << source << " failed\n";
+                    return 1;
+                }
+                ms.push_back(m.ms);
+                rss.push_back(m.rss_mb);
+            }
+            rows.push_back({t.name, n, bench::median(ms), bench::median(rss)});
+            std::snprintf(line, sizeof line, "%-22s %8d %10.1f %10.1f\n", t.name, n, rows.back().ms,
+                          rows.back().rss_mb);
+            std::cout << line << std::flush;
+        }
+    }
+
+    // slopes per technique, minus the baseline's
+    std::vector<cost> costs;
+    double            base_us = 0, base_kb = 0;
+    for (const technique &t : techniques)
+    {
+        std::vector<double> x, ms, rss;
+        for (const row &r : rows)
+        {
+            if (r.name == t.name)
+            {
+                x.push_back(r.count);
+                ms.push_back(r.ms);
+                rss.push_back(r.rss_mb);
+            }
+        }
+        double us = slope(x, ms) * 1e3, kb = slope(x, rss) * 1024;
+        if (costs.empty())
+        {
+            base_us = us;
+            base_kb = kb;
+        }
+        costs.push_back({t.name, us - base_us, kb - base_kb});
+    }
+
+    std::snprintf(line, sizeof line, "\n%-22s %12s %12s\n", "per instantiation", "us", "KB");
+    std::cout << line;
+    for (std::size_t i = 1; i < costs.size(); i++)
+    {
+        std::snprintf(line, sizeof line, "%-22s %12.2f %12.3f\n", costs[i].name.c_str(),
+                      costs[i].us_per_instantiation, costs[i].kb_per_instantiation);
+        std::cout << line;
+    }
+
+    if (!json_path.empty())
+    {
+        std::ofstream json(json_path);
+        json << "{\n  \"compiler\": \"";
+        for (std::size_t i = 0; i < cxx.size(); i++)
+        {
+            json << (i ? " " : "") << cxx[i];
+        }
+        json << "\",\n  \"runs\": [\n";
+        for (std::size_t i = 0; i < rows.size(); i++)
+        {
+            std::snprintf(line, sizeof line,
+                          "    {\"technique\": \"%s\", \"types\": %d, \"ms\": %.3f, \"rss_mb\": %.3f}",
+                          rows[i].name.c_str(), rows[i].count, rows[i].ms, rows[i].rss_mb);
+            json << line << (i + 1 < rows.size() ? ",\n" : "\n");
+        }
+        json << "  ],\n  \"per_instantiation\": [\n";
+        for (std::size_t i = 1; i < costs.size(); i++)
+        {
+            std::snprintf(line, sizeof line, "    {\"technique\": \"%s\", \"us\": %.4f, \"kb\": %.4f}",
+                          costs[i].name.c_str(), costs[i].us_per_instantiation, costs[i].kb_per_instantiation);
+            json << line << (i + 1 < costs.size() ? ",\n" : "\n");
+        }
+        json << "  ]\n}\n";
+    }
+
+    if (keep)
+    {
+        std::cerr << "compile_traits: generated files kept in " << workdir.string() << "\n";
+    }
+    else
+    {
+        std::filesystem::remove_all(workdir);
+    }
+    return 0;
+}
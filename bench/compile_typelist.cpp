@@ -0,0 +1,352 @@
+// Compile-time cost of the constant-depth type-list operations (typelist.hpp) against the naive recursive versions.
+//
+// For each operation, each implementation and each list length N this generates a translation unit. The unit
+// declares N distinct types, applies the operation and compiles it a few times, recording wall time and peak memory
+// (bench::run_process). The reported cost is the unit's median time minus that of a baseline unit which only
+// declares the types and the list.
+//
+//   compile_typelist [--count=N] [--repetitions=N] [--include=DIR] [--json=FILE] [--workdir=DIR] [--keep]
+//                    [-- CXX FLAGS...]
+//
+// The generated files go into a new directory DIR/compile_typelist.XXXXXX (DIR defaults to the system temp
+// directory), which is removed at the end unless --keep is given. Nothing else in DIR is touched.
+//
+// Lengths are count/4, count/2 and count (default 256; the naive versions recurse once per element, and GCC stops at
+// -ftemplate-depth=900). --include is the directory with typelist.hpp (default: .). Everything after `--` is the
+// compiler command (default: c++ -std=c++20).
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harness.hpp"
+
+namespace
+{
+    // the same names as typelist.hpp, one partial specialization per element
+    const char *const naive = R"(#include <cstddef>
+#include <type_traits>
+
+template <typename... Ts>
+struct list
+{
+};
+
+template <typename T, typename L>
+struct push_front;
+template <typename T, typename... Ts>
+struct push_front<T, list<Ts...>>
+{
+    using type = list<T, Ts...>;
+};
+
+template <typename L, std::size_t I>
+struct at;
+template <typename H, typename... Ts>
+struct at<list<H, Ts...>, 0>
+{
+    using type = H;
+};
+template <typename H, typename... Ts, std::size_t I>
+struct at<list<H, Ts...>, I>
+{
+    using type = typename at<list<Ts...>, I - 1>::type;
+};
+template <typename L, std::size_t I>
+using at_t = typename at<L, I>::type;
+
+template <typename L, typename T, std::size_t I = 0>
+struct find
+{
+    static constexpr std::size_t value = I;
+};
+template <typename H, typename... Ts, typename T, std::size_t I>
+struct find<list<H, Ts...>, T, I>
+{
+    static constexpr std::size_t value = std::is_same_v<H, T> ? I : find<list<Ts...>, T, I + 1>::value;
+};
+template <typename L, typename T>
+constexpr std::size_t find_v = find<L, T>::value;
+
+template <typename L, template <typename> class P>
+struct filter
+{
+    using type = list<>;
+};
+template <typename H, typename... Ts, template <typename> class P>
+struct filter<list<H, Ts...>, P>
+{
+    using rest = typename filter<list<Ts...>, P>::type;
+    using type = std::conditional_t<P<H>::value, typename push_front<H, rest>::type, rest>;
+};
+template <typename L, template <typename> class P>
+using filter_t = typename filter<L, P>::type;
+
+template <typename L, template <typename> class F>
+struct transform
+{
+    using type = list<>;
+};
+template <typename H, typename... Ts, template <typename> class F>
+struct transform<list<H, Ts...>, F>
+{
+    using type = typename push_front<F<H>, typename transform<list<Ts...>, F>::type>::type;
+};
+template <typename L, template <typename> class F>
+using transform_t = typename transform<L, F>::type;
+
+template <typename L, typename T>
+struct remove
+{
+    using type = list<>;
+};
+template <typename H, typename... Ts, typename T>
+struct remove<list<H, Ts...>, T>
+{
+    using rest = typename remove<list<Ts...>, T>::type;
+    using type = std::conditional_t<std::is_same_v<H, T>, rest, typename push_front<H, rest>::type>;
+};
+
+template <typename L>
+struct unique
+{
+    using type = list<>;
+};
+template <typename H, typename... Ts>
+struct unique<list<H, Ts...>>
+{
+    using type = typename push_front<H, typename remove<typename unique<list<Ts...>>::type, H>::type>::type;
+};
+template <typename L>
+using unique_t = typename unique<L>::type;
+
+template <typename T, typename L>
+struct insert
+{
+    using type = list<T>;
+};
+template <typename T, typename H, typename... Ts>
+struct insert<T, list<H, Ts...>>
+{
+    using type = std::conditional_t<(sizeof(T) <= sizeof(H)), list<T, H, Ts...>,
+                                    typename push_front<H, typename insert<T, list<Ts...>>::type>::type>;
+};
+template <typename L>
+struct sort
+{
+    using type = list<>;
+};
+template <typename H, typename... Ts>
+struct sort<list<H, Ts...>>
+{
+    using type = typename insert<H, typename sort<list<Ts...>>::type>::type;
+};
+template <typename L>
+using sort_by_size_t = typename sort<L>::type;
+
+)";
+
+    const char *const constant_depth = "#include \"typelist.hpp\"\n\nusing namespace type_lists;\n\n";
+
+    const char *const operations[] = {"baseline", "at", "find", "filter", "transform", "unique", "sort_by_size"};
+
+    std::string
+    generate(bool use_naive, std::string_view op, int n)
+    {
+        std::string src = use_naive ? naive : constant_depth;
+        src += "template <typename T>\nstruct even_size : std::bool_constant<sizeof(T) % 2 == 0>\n{\n};\n\n";
+
+        std::string types, duplicated;
+        for (int i = 0; i < n; i++)
+        {
+            src += "struct t" + std::to_string(i) + "\n{\n    char c[" + std::to_string(i * 7 % 13 + 1) + "];\n};\n";
+            types += (i ? ", t" : "t") + std::to_string(i);
+            if (i < n / 2)
+            {
+                duplicated += ", t" + std::to_string(i);
+            }
+        }
+        src += "\nusing L = list<" + types + ">;\n";
+        src += "using D = list<" + types + duplicated + ">;\n\n";
+
+        if (op == "at")
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                src += "static_assert(sizeof(at_t<L, " + std::to_string(i * (n - 1) / 15) + ">) > 0);\n";
+            }
+        }
+        else if (op == "find")
+        {
+            src += "static_assert(find_v<L, t" + std::to_string(n - 1) + "> == " + std::to_string(n - 1) + ");\n";
+            src += "static_assert(find_v<L, int> == " + std::to_string(n) + ");\n";
+        }
+        else if (op == "filter")
+        {
+            src += "static_assert(sizeof(filter_t<L, even_size>) > 0);\n";
+        }
+        else if (op == "transform")
+        {
+            src += "static_assert(sizeof(transform_t<L, std::add_pointer_t>) > 0);\n";
+        }
+        else if (op == "unique")
+        {
+            src += "static_assert(std::is_same_v<unique_t<D>, L>);\n";
+        }
+        else if (op == "sort_by_size")
+        {
+            src += "static_assert(sizeof(sort_by_size_t<L>) > 0);\n";
+        }
+        return src;
+    }
+
+    struct row
+    {
+        std::string op;
+        const char *impl;
+        int         n;
+        double      ms;
+        double      rss_mb;
+    };
+
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    int                      count       = 256;
+    int                      repetitions = 3;
+    bool                     keep        = false;
+    std::string              include     = ".";
+    std::string              json_path;
+    std::filesystem::path    workdir = std::filesystem::temp_directory_path();
+    std::vector<std::string> cxx;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--")
+        {
+            cxx.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        else if (arg.substr(0, 8) == "--count=")
+        {
+            count = std::atoi(argv[i] + 8);
+        }
+        else if (arg.substr(0, 14) == "--repetitions=")
+        {
+            repetitions = std::atoi(argv[i] + 14);
+        }
+        else if (arg.substr(0, 10) == "--include=")
+        {
+            include = arg.substr(10);
+        }
+        else if (arg.substr(0, 7) == "--json=")
+        {
+            json_path = arg.substr(7);
+        }
+        else if (arg.substr(0, 10) == "--workdir=")
+        {
+            workdir = arg.substr(10);
+        }
+        else if (arg == "--keep")
+        {
+            keep = true;
+        }
+        else
+        {
+            std::cerr << "usage: compile_typelist [--count=N] [--repetitions=N] [--include=DIR] [--json=FILE]"
+                         " [--workdir=DIR] [--keep] [-- CXX FLAGS...]\n";
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+    if (cxx.empty())
+    {
+        cxx = {"c++", "-std=c++20"};
+    }
+    if (count < 8 || repetitions < 1)
+    {
+        std::cerr << "compile_typelist: --count must be at least 8 and --repetitions at least 1\n";
+        return 2;
+    }
+    include = std::filesystem::absolute(include).string();
+    workdir = bench::make_scratch_dir(workdir, "compile_typelist"); // only this is removed at the end
+
+    const int        counts[] = {count / 4, count / 2, count};
+    std::vector<row> rows;
+    char             line[160];
+    std::snprintf(line, sizeof line, "%-14s %-9s %6s %10s %10s %12s\n", "operation", "impl", "types", "ms",
+                  "cost ms", "max RSS MB");
+    std::cout << line;
+    for (const char *impl : {"naive", "constant"})
+    {
+        for (int n : counts)
+        {
+            double baseline_ms = 0;
+            for (std::string_view op : operations)
+            {
+                std::string           name   = std::string(op) + "_" + impl + "_" + std::to_string(n) + ".cpp";
+                std::filesystem::path source = workdir / name;
+                std::ofstream(source) << generate(impl[0] == 'n', op, n);
+
+                std::vector<double> ms, rss;
+                for (int r = 0; r < repetitions; r++)
+                {
+                    bench::process_stats p = bench::run_process(
+                        [&] {
+                            std::vector<std::string> args = cxx;
+                            args.insert(args.end(), {"-I" + include, "-fsyntax-only", source.string()});
+                            return args;
+                        }());
+                    if (!p.ok)
+                    {
+                        std::cerr << "compile_typelist: compiling " << source << " failed\n";
+                        return 1;
+                    }
+                    ms.push_back(p.ms);
+                    rss.push_back(p.rss_mb);
+                }
+                row r = {std::string(op), impl, n, bench::median(ms), bench::median(rss)};
+                if (op == "baseline")
+                {
+                    baseline_ms = r.ms;
+                }
+                rows.push_back(r);
+                std::snprintf(line, sizeof line, "%-14s %-9s %6d %10.1f %10.1f %12.1f\n", r.op.c_str(), impl, n, r.ms,
+                              r.ms - baseline_ms, r.rss_mb);
+                std::cout << line << std::flush;
+            }
+        }
+    }
+
+    if (!json_path.empty())
+    {
+        std::ofstream json(json_path);
+        json << "{\n  \"runs\": [\n";
+        for (std::size_t i = 0; i < rows.size(); i++)
+        {
+            std::snprintf(line, sizeof line,
+                          "    {\"operation\": \"%s\", \"impl\": \"%s\", \"types\": %d, \"ms\": %.3f,"
+                          " \"rss_mb\": %.3f}",
+                          rows[i].op.c_str(), rows[i].impl, rows[i].n, rows[i].ms, rows[i].rss_mb);
+            json << line << (i + 1 < rows.size() ? ",\n" : "\n");
+        }
+        json << "  ]\n}\n";
+    }
+
+    if (keep)
+    {
+        std::cerr << "compile_typelist: generated files kept in " << workdir.string() << "\n";
+    }
+    else
+    {
+        std::filesystem::remove_all(workdir);
+    }
+    return 0;
+}
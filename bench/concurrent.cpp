@@ -0,0 +1,110 @@
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        // what the lock-free containers replace
+        template <typename T>
+        struct locked_deque
+        {
+            std::mutex    m;
+            std::deque<T> d;
+
+            void
+            push(T x)
+            {
+                std::lock_guard lock(m);
+                d.push_back(std::move(x));
+            }
+
+            std::optional<T>
+            try_pop()
+            {
+                std::lock_guard lock(m);
+                if (d.empty())
+                {
+                    return std::nullopt;
+                }
+                T x = std::move(d.front());
+                d.pop_front();
+                return x;
+            }
+        };
+
+        // One operation = one push by each of `producers` threads, and as many pops, spread over `consumers`
+        // threads (which spin on try_pop while the container is empty). items = elements passed through.
+        template <typename Container>
+        void
+        add_mpmc(registry &r, const std::string &name, std::size_t producers, std::size_t consumers)
+        {
+            r.add(
+                "concurrent/" + name + "/" + std::to_string(producers) + "p" + std::to_string(consumers) + "c",
+                [producers, consumers](std::size_t iterations) {
+                    Container                c;
+                    std::atomic<std::size_t> popped{0};
+                    std::size_t              total = producers * iterations;
+                    std::vector<std::thread> threads;
+                    for (std::size_t p = 0; p < producers; p++)
+                    {
+                        threads.emplace_back([&] {
+                            for (std::size_t i = 0; i < iterations; i++)
+                            {
+                                c.push(i);
+                            }
+                        });
+                    }
+                    for (std::size_t q = 0; q < consumers; q++)
+                    {
+                        threads.emplace_back([&] {
+                            std::size_t sum = 0;
+                            while (popped.load(std::memory_order_relaxed) < total)
+                            {
+                                if (auto x = c.try_pop())
+                                {
+                                    sum += *x;
+                                    popped.fetch_add(1, std::memory_order_relaxed);
+                                }
+                            }
+                            do_not_optimize(sum);
+                        });
+                    }
+                    for (auto &t : threads)
+                    {
+                        t.join();
+                    }
+                },
+                producers);
+        }
+
+        template <typename Container>
+        void
+        add_container(registry &r, const std::string &name)
+        {
+            for (std::size_t threads : {1, 2, 4})
+            {
+                add_mpmc<Container>(r, name, threads, threads);
+            }
+        }
+
+    } // namespace
+
+    void
+    add_concurrent(registry &r)
+    {
+        add_container<locked_deque<std::size_t>>(r, "mutex_deque");
+        add_container<concurrent::queue<std::size_t>>(r, "queue");
+        add_container<concurrent::stack<std::size_t>>(r, "stack");
+    }
+
+} // namespace bench
@@ -0,0 +1,98 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "counters.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr std::size_t threads = 4;
+
+        struct event
+        {
+        };
+
+        // what counter<T> replaces: a map keyed by type, looked up on every increment
+        struct map_counters
+        {
+            std::mutex                                         m;
+            std::unordered_map<std::type_index, std::uint64_t> counts;
+
+            void
+            add(std::type_index t)
+            {
+                std::lock_guard lock(m);
+                counts[t]++;
+            }
+        };
+
+        // one operation = one increment in each of `threads` threads, all incrementing the same metric
+        template <typename Increment>
+        void
+        add_contended(registry &r, std::string name, Increment increment)
+        {
+            r.add(
+                std::move(name),
+                [increment](std::size_t iterations) {
+                    std::vector<std::thread> pool;
+                    for (std::size_t t = 0; t < threads; t++)
+                    {
+                        pool.emplace_back([&] {
+                            for (std::size_t it = 0; it < iterations; it++)
+                            {
+                                increment();
+                            }
+                        });
+                    }
+                    for (auto &t : pool)
+                    {
+                        t.join();
+                    }
+                },
+                threads);
+        }
+
+    } // namespace
+
+    void
+    add_counters(registry &r)
+    {
+        static map_counters               map;
+        static std::atomic<std::uint64_t> shared{0};
+
+        r.add("counters/add/type_index_map", [](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; it++)
+            {
+                map.add(typeid(event));
+            }
+        });
+        r.add("counters/add/counter<T>", [](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; it++)
+            {
+                counters::counter<event>::add();
+            }
+        });
+        r.add("counters/record/histogram<T>", [](std::size_t iterations) {
+            for (std::size_t it = 0; it < iterations; it++)
+            {
+                std::uint64_t value = it;
+                do_not_optimize(value);
+                counters::histogram<event>::record(value);
+            }
+        });
+
+        // the point of the shards: the same increments with `threads` threads
+        add_contended(r, "counters/add_4_threads/shared_atomic",
+                      [] { shared.fetch_add(1, std::memory_order_relaxed); });
+        add_contended(r, "counters/add_4_threads/counter<T>", [] { counters::counter<event>::add(); });
+    }
+
+} // namespace bench
@@ -0,0 +1,167 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "expression.hpp"
+#include "myabs.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        // What the operators would be without expression templates: every operation returns a new vector, so
+        // `a + b * c - abs(d)` allocates, writes and reads back three temporaries.
+        namespace eager
+        {
+            template <typename T, typename U, typename Op>
+            std::vector<std::common_type_t<T, U>>
+            zip(const std::vector<T> &a, const std::vector<U> &b, Op op)
+            {
+                std::vector<std::common_type_t<T, U>> r(a.size());
+                for (std::size_t i = 0; i < a.size(); i++)
+                {
+                    r[i] = op(a[i], b[i]);
+                }
+                return r;
+            }
+
+            template <typename T, typename U>
+            auto
+            operator+(const std::vector<T> &a, const std::vector<U> &b)
+            {
+                return zip(a, b, [](auto x, auto y) { return x + y; });
+            }
+
+            template <typename T, typename U>
+            auto
+            operator-(const std::vector<T> &a, const std::vector<U> &b)
+            {
+                return zip(a, b, [](auto x, auto y) { return x - y; });
+            }
+
+            template <typename T, typename U>
+            auto
+            operator*(const std::vector<T> &a, const std::vector<U> &b)
+            {
+                return zip(a, b, [](auto x, auto y) { return x * y; });
+            }
+
+            template <typename T>
+            std::vector<T>
+            abs(const std::vector<T> &a)
+            {
+                std::vector<T> r(a.size());
+                for (std::size_t i = 0; i < a.size(); i++)
+                {
+                    r[i] = function_templates::myabs(a[i]);
+                }
+                return r;
+            }
+
+        } // namespace eager
+
+        template <typename T>
+        std::vector<T>
+        input(std::size_t n, unsigned seed)
+        {
+            std::mt19937   gen(seed);
+            std::vector<T> v(n);
+            for (T &x : v)
+            {
+                x = static_cast<T>(static_cast<int>(gen() % 2001) - 1000);
+            }
+            return v;
+        }
+
+        // r = a + b * c - abs(d), with a of type A and the others of type T
+        template <typename A, typename T>
+        void
+        add_size(registry &r, const std::string &types, std::size_t n, const std::string &size)
+        {
+            using R            = std::common_type_t<A, T>;
+            std::string prefix = "expression/" + types + "/" + size + "/";
+            auto        a      = input<A>(n, 1);
+            auto        b      = input<T>(n, 2);
+            auto        c      = input<T>(n, 3);
+            auto        d      = input<T>(n, 4);
+
+            r.add(
+                prefix + "eager",
+                [a, b, c, d](std::size_t iterations) {
+                    using namespace eager;
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        std::vector<R> out = a + b * c - abs(d);
+                        do_not_optimize(out.data());
+                        clobber_memory();
+                    }
+                },
+                n);
+
+            // into a new vector each time, like eager (one allocation instead of four)
+            r.add(
+                prefix + "lazy",
+                [a, b, c, d](std::size_t iterations) {
+                    using namespace expression_templates;
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        std::vector<R> out = a + b * c - abs(d);
+                        do_not_optimize(out.data());
+                        clobber_memory();
+                    }
+                },
+                n);
+
+            // into the same vector every time: no allocation at all
+            r.add(
+                prefix + "lazy_assign",
+                [a, b, c, d, out = std::vector<R>(n)](std::size_t iterations) mutable {
+                    using namespace expression_templates;
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        assign(out, a + b * c - abs(d));
+                        do_not_optimize(out.data());
+                        clobber_memory();
+                    }
+                },
+                n);
+
+            // what the fused loop should compare to
+            r.add(
+                prefix + "hand_written",
+                [a, b, c, d, out = std::vector<R>(n)](std::size_t iterations) mutable {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        for (std::size_t i = 0; i < out.size(); i++)
+                        {
+                            out[i] = a[i] + R(b[i] * c[i]) - function_templates::myabs(d[i]);
+                        }
+                        do_not_optimize(out.data());
+                        clobber_memory();
+                    }
+                },
+                n);
+        }
+
+        template <typename A, typename T>
+        void
+        add_types(registry &r, const std::string &types)
+        {
+            add_size<A, T>(r, types, 4096, "4K");                 // in cache: the temporaries' extra loops
+            add_size<A, T>(r, types, std::size_t(1) << 22, "4M"); // out of cache: their extra memory traffic
+        }
+
+    } // namespace
+
+    void
+    add_expression(registry &r)
+    {
+        add_types<double, double>(r, "double");
+        add_types<float, float>(r, "float");
+        add_types<int, double>(r, "int+double");
+    }
+
+} // namespace bench
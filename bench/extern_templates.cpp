@@ -0,0 +1,296 @@
+// What the `templates` library and the extern template declarations in instantiations.hpp save.
+//
+// This generates --units consumer translation units that use myabs, the batch overflow_policies::abs, mylist, tree
+// and advance with int, long, float and double. It then builds them into one program in two ways:
+//
+//   implicit  the units include the plain headers and each one instantiates everything it uses
+//   extern    the units include instantiations.hpp and link instantiations.cpp, which is compiled once
+//
+// It reports the compile time of all units, the time to rebuild one unit after an edit, the total object size and
+// the size of the linked program.
+//
+//   extern_templates [--units=N] [--repetitions=N] [--include=DIR] [--json=FILE] [--workdir=DIR] [--keep]
+//                    [-- CXX FLAGS...]
+//
+// The generated files go into a new directory DIR/extern_templates.XXXXXX (DIR defaults to the system temp
+// directory), which is removed at the end unless --keep is given. Nothing else in DIR is touched.
+//
+// --include is the directory with the headers (default: .). Everything after `--` is the compiler command (default:
+// c++ -std=c++20 -O2).
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harness.hpp"
+
+namespace
+{
+    // %1$s is the element type, %2$d the unit number
+    const char *const use_common = "    {\n"
+                                   "        std::vector<%1$s> v(64);\n"
+                                   "        for (std::size_t k = 0; k < v.size(); k++)\n"
+                                   "        {\n"
+                                   "            v[k] = static_cast<%1$s>(int(k) - 32 + %2$d);\n"
+                                   "        }\n"
+                                   "        function_templates::myabs(std::span<%1$s>(v));\n"
+                                   "        sum += static_cast<long>(function_templates::myabs(%1$s(-%2$d)));\n"
+                                   "        class_templates::mylist<%1$s> l;\n"
+                                   "        good_tag_dispatch::tree<%1$s> t;\n"
+                                   "        for (%1$s x : v)\n"
+                                   "        {\n"
+                                   "            l.push_back(x);\n"
+                                   "            t.insert(x);\n"
+                                   "        }\n"
+                                   "        sum += static_cast<long>(*good_tag_dispatch::advance(l.begin(), 3));\n"
+                                   "        sum += static_cast<long>(*good_tag_dispatch::advance(t.begin(), 3));\n"
+                                   "        t.erase(t.begin());\n"
+                                   "        l.erase(l.begin());\n"
+                                   "        sum += static_cast<long>(t.size() + l.size());\n"
+                                   "    }\n";
+
+    const char *const use_integral = "    {\n"
+                                     "        std::vector<%1$s> in(64, -%2$d), out(64);\n"
+                                     "        std::span<%1$s> o(out);\n"
+                                     "        sum += overflow_policies::abs<overflow_policies::saturate>(in, o);\n"
+                                     "        sum += overflow_policies::abs(in, o);\n"
+                                     "        sum += static_cast<long>(out[0]);\n"
+                                     "    }\n";
+
+    std::string
+    format(const char *pattern, const char *type, int unit)
+    {
+        char buffer[2048];
+        std::snprintf(buffer, sizeof buffer, pattern, type, unit);
+        return buffer;
+    }
+
+    std::string
+    consumer(bool use_extern, int unit)
+    {
+        std::string src = use_extern ? "#include \"instantiations.hpp\"\n"
+                                     : "#include \"abs_policy.hpp\"\n"
+                                       "#include \"advance.hpp\"\n"
+                                       "#include \"myabs.hpp\"\n"
+                                       "#include \"mylist.hpp\"\n"
+                                       "#include \"tree.hpp\"\n";
+        src += "#include <span>\n#include <vector>\n\n";
+        src += "long\nconsumer_" + std::to_string(unit) + "()\n{\n    long sum = 0;\n";
+        for (const char *type : {"int", "long", "float", "double"})
+        {
+            src += format(use_common, type, unit);
+        }
+        for (const char *type : {"int", "long"})
+        {
+            src += format(use_integral, type, unit);
+        }
+        return src + "    return sum;\n}\n";
+    }
+
+    std::string
+    program(int units)
+    {
+        std::string src;
+        for (int i = 0; i < units; i++)
+        {
+            src += "long\nconsumer_" + std::to_string(i) + "();\n";
+        }
+        src += "\nint\nmain()\n{\n    long sum = 0;\n";
+        for (int i = 0; i < units; i++)
+        {
+            src += "    sum += consumer_" + std::to_string(i) + "();\n";
+        }
+        return src + "    return sum == 42;\n}\n";
+    }
+
+    struct build
+    {
+        const char *name;
+        double      compile_ms      = 0; // all consumer units (medians)
+        double      max_unit_ms     = 0; // slowest consumer unit: rebuild after editing it, before linking
+        double      library_ms      = 0; // instantiations.cpp, compiled once
+        double      link_ms         = 0;
+        std::size_t object_bytes    = 0; // consumer units
+        std::size_t library_bytes   = 0;
+        std::size_t program_bytes   = 0;
+        double      max_rss_mb      = 0;
+    };
+
+    double
+    compile(const std::vector<std::string> &cxx, const std::vector<std::string> &extra, int repetitions,
+            build &b)
+    {
+        std::vector<std::string> args = cxx;
+        args.insert(args.end(), extra.begin(), extra.end());
+        std::vector<double> ms;
+        for (int r = 0; r < repetitions; r++)
+        {
+            bench::process_stats p = bench::run_process(args);
+            if (!p.ok)
+            {
+                std::string command;
+                for (const std::string &a : args)
+                {
+                    command += a + ' ';
+                }
+                std::cerr << "extern_templates: failed: " << command << '\n';
+                std::exit(1);
+            }
+            ms.push_back(p.ms);
+            b.max_rss_mb = std::max(b.max_rss_mb, p.rss_mb);
+        }
+        return bench::median(ms);
+    }
+
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    int                      units       = 8;
+    int                      repetitions = 3;
+    bool                     keep        = false;
+    std::string              include     = ".";
+    std::string              json_path;
+    std::filesystem::path    workdir = std::filesystem::temp_directory_path();
+    std::vector<std::string> cxx;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--")
+        {
+            cxx.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        else if (arg.substr(0, 8) == "--units=")
+        {
+            units = std::atoi(argv[i] + 8);
+        }
+        else if (arg.substr(0, 14) == "--repetitions=")
+        {
+            repetitions = std::atoi(argv[i] + 14);
+        }
+        else if (arg.substr(0, 10) == "--include=")
+        {
+            include = arg.substr(10);
+        }
+        else if (arg.substr(0, 7) == "--json=")
+        {
+            json_path = arg.substr(7);
+        }
+        else if (arg.substr(0, 10) == "--workdir=")
+        {
+            workdir = arg.substr(10);
+        }
+        else if (arg == "--keep")
+        {
+            keep = true;
+        }
+        else
+        {
+            std::cerr << "usage: extern_templates [--units=N] [--repetitions=N] [--include=DIR] [--json=FILE]"
+                         " [--workdir=DIR] [--keep] [-- CXX FLAGS...]\n";
+            return arg == "--help" ? 0 : 2;
+        }
+    }
+    if (cxx.empty())
+    {
+        cxx = {"c++", "-std=c++20", "-O2"};
+    }
+    if (units < 1 || repetitions < 1)
+    {
+        std::cerr << "extern_templates: --units and --repetitions must be at least 1\n";
+        return 2;
+    }
+    include = std::filesystem::absolute(include).string();
+    workdir = bench::make_scratch_dir(workdir, "extern_templates"); // only this is removed at the end
+    auto path = [&](const std::string &name) { return (workdir / name).string(); };
+
+    build builds[] = {{"implicit"}, {"extern"}};
+    for (build &b : builds)
+    {
+        const bool               use_extern = &b == &builds[1];
+        std::vector<std::string> link       = {"-o", path(std::string(b.name) + "_program")};
+
+        for (int i = 0; i < units; i++)
+        {
+            std::string source = path(std::string(b.name) + "_" + std::to_string(i) + ".cpp");
+            std::ofstream(source) << consumer(use_extern, i);
+            double ms = compile(cxx, {"-I" + include, "-c", source, "-o", source + ".o"}, repetitions, b);
+            b.compile_ms += ms;
+            b.max_unit_ms = std::max(b.max_unit_ms, ms);
+            b.object_bytes += std::filesystem::file_size(source + ".o");
+            link.push_back(source + ".o");
+        }
+
+        std::string main_source = path(std::string(b.name) + "_main.cpp");
+        std::ofstream(main_source) << program(units);
+        compile(cxx, {"-c", main_source, "-o", main_source + ".o"}, 1, b);
+        link.push_back(main_source + ".o");
+
+        if (use_extern)
+        {
+            std::string library = path("instantiations.o");
+            b.library_ms        = compile(
+                cxx, {"-I" + include, "-c", include + "/instantiations.cpp", "-o", library}, repetitions, b);
+            b.library_bytes = std::filesystem::file_size(library);
+            link.push_back(library);
+        }
+
+        b.link_ms       = compile(cxx, link, repetitions, b);
+        b.program_bytes = std::filesystem::file_size(path(std::string(b.name) + "_program"));
+    }
+
+    char line[200];
+    std::snprintf(line, sizeof line, "%-10s %12s %12s %12s %10s %12s %12s %12s %10s\n", "build", "units ms",
+                  "rebuild ms", "library ms", "link ms", "objects KB", "library KB", "program KB", "RSS MB");
+    std::cout << "units: " << units << '\n' << line;
+    for (const build &b : builds)
+    {
+        std::snprintf(line, sizeof line, "%-10s %12.1f %12.1f %12.1f %10.1f %12.1f %12.1f %12.1f %10.1f\n", b.name,
+                      b.compile_ms, b.max_unit_ms, b.library_ms, b.link_ms, b.object_bytes / 1024.0,
+                      b.library_bytes / 1024.0, b.program_bytes / 1024.0, b.max_rss_mb);
+        std::cout << line;
+    }
+    const build &a = builds[0], &e = builds[1];
+    std::snprintf(line, sizeof line,
+                  "\nextern saves %.1f%% of the unit compile time (%.1f%% including the library), %.1f%% of the "
+                  "object size and %.1f%% of the program size\n",
+                  100 * (1 - e.compile_ms / a.compile_ms), 100 * (1 - (e.compile_ms + e.library_ms) / a.compile_ms),
+                  100 * (1 - double(e.object_bytes) / a.object_bytes),
+                  100 * (1 - double(e.program_bytes) / a.program_bytes));
+    std::cout << line;
+
+    if (!json_path.empty())
+    {
+        std::ofstream json(json_path);
+        json << "{\n  \"units\": " << units << ",\n  \"builds\": [\n";
+        for (const build &b : builds)
+        {
+            std::snprintf(line, sizeof line,
+                          "    {\"name\": \"%s\", \"units_ms\": %.3f, \"rebuild_ms\": %.3f, \"library_ms\": %.3f, "
+                          "\"link_ms\": %.3f, \"object_bytes\": %zu, \"library_bytes\": %zu, \"program_bytes\": %zu}",
+                          b.name, b.compile_ms, b.max_unit_ms, b.library_ms, b.link_ms, b.object_bytes,
+                          b.library_bytes, b.program_bytes);
+            json << line << (&b == &builds[0] ? ",\n" : "\n");
+        }
+        json << "  ]\n}\n";
+    }
+
+    if (keep)
+    {
+        std::cerr << "extern_templates: generated files kept in " << workdir.string() << "\n";
+    }
+    else
+    {
+        std::filesystem::remove_all(workdir);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "format.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        // One line per item, "<int> <double> <string>", written to /dev/null so only the formatting and buffering
+        // are measured. 1e9 / (ns/item) is lines per second.
+        //
+        //   iostream_endl  std::ofstream << ... << std::endl (a flush, i.e. a write(2), per line)
+        //   iostream       the same with '\n'
+        //   printf         std::fprintf (%g, so 6 significant digits instead of the shortest exact form)
+        //   sink           formatting::println into a sink
+        //   format         formatting::format into a new std::string per line (no output)
+        constexpr double      value = 3.14159;
+        constexpr const char *text  = "items";
+
+        struct devnull
+        {
+            std::FILE *file = std::fopen("/dev/null", "w");
+
+            devnull() = default;
+
+            devnull(const devnull &) = delete;
+            devnull &
+            operator=(const devnull &) = delete;
+
+            ~devnull()
+            {
+                std::fclose(file);
+            }
+        };
+
+    } // namespace
+
+    void
+    add_format(registry &r)
+    {
+        r.add(
+            "format/iostream_endl",
+            [](std::size_t iterations) {
+                std::ofstream out("/dev/null");
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    out << i << ' ' << value << ' ' << text << std::endl;
+                }
+            },
+            1);
+
+        r.add(
+            "format/iostream",
+            [](std::size_t iterations) {
+                std::ofstream out("/dev/null");
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    out << i << ' ' << value << ' ' << text << '\n';
+                }
+            },
+            1);
+
+        r.add(
+            "format/printf",
+            [](std::size_t iterations) {
+                devnull out;
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    std::fprintf(out.file, "%zu %g %s\n", i, value, text);
+                }
+            },
+            1);
+
+        r.add(
+            "format/sink",
+            [](std::size_t iterations) {
+                devnull           null;
+                formatting::sink out(null.file);
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    println(out, "{} {} {}", i, value, text);
+                }
+            },
+            1);
+
+        r.add(
+            "format/format",
+            [](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    std::string s = formatting::format("{} {} {}", i, value, text);
+                    do_not_optimize(s);
+                }
+            },
+            1);
+    }
+
+} // namespace bench
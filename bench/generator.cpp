@@ -0,0 +1,141 @@
+#include <cstddef>
+#include <string>
+
+#include "generator.hpp"
+#include "mylist.hpp"
+#include "segmented.hpp"
+#include "suites.hpp"
+#include "tree.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr int size = 1 << 16;
+
+        template <typename Container>
+        Container
+        filled()
+        {
+            Container c;
+            for (int i = 0; i < size; i++)
+            {
+                if constexpr (requires { c.push_back(i); })
+                {
+                    c.push_back(i);
+                }
+                else
+                {
+                    c.insert(i);
+                }
+            }
+            return c;
+        }
+
+        // one operation = summing all elements; items = elements
+        template <typename Container, typename Sum>
+        void
+        add_sum(registry &r, std::string name, Sum sum)
+        {
+            r.add(
+                std::move(name),
+                [c = filled<Container>(), sum](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        long s = sum(c);
+                        do_not_optimize(s);
+                    }
+                },
+                size);
+        }
+
+        template <typename Container>
+        void
+        add_container(registry &r, const std::string &type)
+        {
+            using namespace coroutines;
+
+            add_sum<Container>(r, "generator/" + type + "/iterator", [](const Container &c) {
+                long s = 0;
+                for (int x : c)
+                {
+                    s += x;
+                }
+                return s;
+            });
+            add_sum<Container>(r, "generator/" + type + "/segmented_for_each", [](const Container &c) {
+                long s = 0;
+                good_tag_dispatch::for_each(c.begin(), c.end(), [&](int x) { s += x; });
+                return s;
+            });
+            add_sum<Container>(r, "generator/" + type + "/in_order", [](const Container &c) {
+                long s = 0;
+                for (int x : in_order(c))
+                {
+                    s += x;
+                }
+                return s;
+            });
+            // two more coroutines stacked on top: every element passes through three resumptions
+            add_sum<Container>(r, "generator/" + type + "/in_order_filter_transform", [](const Container &c) {
+                auto even = [](int x) { return x % 2 == 0; };
+                auto half = [](int x) { return x / 2; };
+                long s    = 0;
+                for (int x : transform(filter(in_order(c), even), half))
+                {
+                    s += x;
+                }
+                return s;
+            });
+        }
+
+        coroutines::generator<int, coroutines::frames::heap>
+        heap_count(int n)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                co_yield i;
+            }
+        }
+
+        coroutines::generator<int>
+        pooled_count(int n)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                co_yield i;
+            }
+        }
+
+        // one operation = creating a generator of 4 elements, draining it and destroying it
+        template <typename Make>
+        void
+        add_short(registry &r, std::string name, Make make)
+        {
+            r.add(std::move(name), [make](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; it++)
+                {
+                    int s = 4;
+                    do_not_optimize(s);
+                    for (int x : make(s))
+                    {
+                        s += x;
+                    }
+                    do_not_optimize(s);
+                }
+            });
+        }
+
+    } // namespace
+
+    void
+    add_generator(registry &r)
+    {
+        add_container<good_tag_dispatch::tree<int>>(r, "tree");
+        add_container<class_templates::mylist<int>>(r, "mylist");
+
+        add_short(r, "generator/short/heap_frames", heap_count);
+        add_short(r, "generator/short/pooled_frames", pooled_count);
+    }
+
+} // namespace bench
@@ -0,0 +1,292 @@
+#include "harness.hpp"
+
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cerrno>
+#include <cstdio>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace bench
+{
+    double
+    median(std::vector<double> v)
+    {
+        if (v.empty())
+        {
+            return 0;
+        }
+        std::size_t mid = v.size() / 2;
+        std::nth_element(v.begin(), v.begin() + mid, v.end());
+        double m = v[mid];
+        if (v.size() % 2 == 0)
+        {
+            m = (m + *std::max_element(v.begin(), v.begin() + mid)) / 2;
+        }
+        return m;
+    }
+
+    std::filesystem::path
+    make_scratch_dir(const std::filesystem::path &parent, const std::string &prefix)
+    {
+        std::filesystem::create_directories(parent);
+        std::string name = (parent / (prefix + ".XXXXXX")).string();
+        if (mkdtemp(name.data()) == nullptr)
+        {
+            throw std::filesystem::filesystem_error("mkdtemp", parent, std::error_code(errno, std::generic_category()));
+        }
+        return name;
+    }
+
+    process_stats
+    run_process(std::vector<std::string> args)
+    {
+        std::vector<char *> argv;
+        for (std::string &a : args)
+        {
+            argv.push_back(a.data());
+        }
+        argv.push_back(nullptr);
+
+        auto  start = std::chrono::steady_clock::now();
+        pid_t pid   = fork();
+        if (pid == 0)
+        {
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        process_stats p;
+        int           status = 0;
+        struct rusage usage  = {};
+        if (pid < 0 || wait4(pid, &status, 0, &usage) != pid)
+        {
+            return p;
+        }
+        auto stop = std::chrono::steady_clock::now();
+        p.ms      = std::chrono::duration<double, std::milli>(stop - start).count();
+        p.rss_mb  = static_cast<double>(usage.ru_maxrss) / 1024; // KiB on Linux
+        p.ok      = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        return p;
+    }
+
+    namespace
+    {
+        double
+        time_ns(const benchmark &b, std::size_t iterations)
+        {
+            auto start = std::chrono::steady_clock::now();
+            b.body(iterations);
+            auto stop = std::chrono::steady_clock::now();
+            return std::chrono::duration<double, std::nano>(stop - start).count();
+        }
+
+        // doubles the iteration count until one repetition takes min_time, then scales to it
+        std::size_t
+        calibrate(const benchmark &b, double min_time_ns)
+        {
+            std::size_t iterations = 1;
+            for (;;)
+            {
+                double t = time_ns(b, iterations);
+                if (t >= min_time_ns)
+                {
+                    return iterations;
+                }
+                if (t * 4 >= min_time_ns)
+                {
+                    return static_cast<std::size_t>(std::ceil(iterations * min_time_ns / std::max(t, 1.0)));
+                }
+                iterations *= 2;
+            }
+        }
+
+        std::string
+        escape(const std::string &s)
+        {
+            std::string out;
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out += '\\';
+                }
+                out += c;
+            }
+            return out;
+        }
+
+        // value of "key": in a single-line JSON object (strings without escapes other than \" and \\)
+        bool
+        field(const std::string &line, const std::string &key, std::string &value)
+        {
+            std::size_t at = line.find("\"" + key + "\":");
+            if (at == std::string::npos)
+            {
+                return false;
+            }
+            at = line.find_first_not_of(' ', at + key.size() + 3);
+            if (at == std::string::npos)
+            {
+                return false;
+            }
+            value.clear();
+            if (line[at] == '"')
+            {
+                for (std::size_t i = at + 1; i < line.size() && line[i] != '"'; i++)
+                {
+                    if (line[i] == '\\' && i + 1 < line.size())
+                    {
+                        i++;
+                    }
+                    value += line[i];
+                }
+                return true;
+            }
+            std::size_t end = line.find_first_of(",}", at);
+            value           = line.substr(at, end - at);
+            return true;
+        }
+
+        // all of `value` must be a number (no std::stod: it throws std::invalid_argument without context)
+        double
+        number(const std::string &value, const std::string &key, std::size_t line)
+        {
+            const char *first = value.data();
+            const char *last  = first + value.find_last_not_of(' ') + 1;
+            double      x{};
+            auto [end, ec]    = std::from_chars(first, last, x);
+            if (value.empty() || ec != std::errc() || end != last)
+            {
+                throw std::runtime_error("line " + std::to_string(line) + ": \"" + key + "\" is not a number: \"" +
+                                         value + "\"");
+            }
+            return x;
+        }
+
+    } // namespace
+
+    result
+    run(const benchmark &b, const options &o)
+    {
+        const double min_time_ns = o.min_time_ms * 1e6;
+        std::size_t  iterations  = calibrate(b, min_time_ns);
+
+        for (int i = 0; i < o.warmup; i++)
+        {
+            time_ns(b, iterations);
+        }
+
+        std::vector<double> samples;
+        for (int i = 0; i < o.repetitions; i++)
+        {
+            samples.push_back(time_ns(b, iterations) / static_cast<double>(iterations * b.items));
+        }
+
+        double              med = median(samples);
+        std::vector<double> deviations;
+        for (double s : samples)
+        {
+            deviations.push_back(std::abs(s - med));
+        }
+
+        return {b.name, med, median(deviations), iterations, o.repetitions, b.items};
+    }
+
+    void
+    write_json(std::ostream &os, const std::vector<result> &results)
+    {
+        os << "{\n  \"unit\": \"ns per item\",\n  \"benchmarks\": [\n";
+        for (std::size_t i = 0; i < results.size(); i++)
+        {
+            const result &r = results[i];
+            char          numbers[160];
+            std::snprintf(numbers, sizeof numbers,
+                          "\"median_ns\": %.6g, \"mad_ns\": %.6g, \"iterations\": %zu, \"repetitions\": %d, "
+                          "\"items\": %zu",
+                          r.median_ns, r.mad_ns, r.iterations, r.repetitions, r.items);
+            os << "    {\"name\": \"" << escape(r.name) << "\", " << numbers << "}"
+               << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        os << "  ]\n}\n";
+    }
+
+    std::vector<result>
+    read_json(std::istream &is)
+    {
+        std::vector<result> results;
+        std::string         line;
+        for (std::size_t line_number = 1; std::getline(is, line); line_number++)
+        {
+            result      r;
+            std::string value;
+            if (!field(line, "name", r.name) || !field(line, "median_ns", value))
+            {
+                continue;
+            }
+            r.median_ns = number(value, "median_ns", line_number);
+            if (field(line, "mad_ns", value))
+            {
+                r.mad_ns = number(value, "mad_ns", line_number);
+            }
+            results.push_back(r);
+        }
+        return results;
+    }
+
+    int
+    compare(const std::vector<result> &current, const std::vector<result> &baseline, double threshold,
+            std::ostream &os)
+    {
+        std::map<std::string, const result *> base;
+        for (const result &r : baseline)
+        {
+            base[r.name] = &r;
+        }
+
+        int  regressions = 0;
+        char line[256];
+        std::snprintf(line, sizeof line, "\n%-48s %12s %12s %9s\n", "benchmark", "baseline ns", "current ns",
+                      "change");
+        os << line;
+        for (const result &r : current)
+        {
+            auto it = base.find(r.name);
+            if (it == base.end())
+            {
+                std::snprintf(line, sizeof line, "%-48s %12s %12.3f %9s\n", r.name.c_str(), "-", r.median_ns, "new");
+                os << line;
+                continue;
+            }
+            const result &b      = *it->second;
+            double        delta  = r.median_ns - b.median_ns;
+            double        change = b.median_ns > 0 ? delta / b.median_ns : 0;
+            double        noise  = 3 * std::max(r.mad_ns, b.mad_ns);
+
+            const char *flag = "";
+            if (change > threshold && delta > noise)
+            {
+                flag = "  REGRESSION";
+                regressions++;
+            }
+            else if (-change > threshold && -delta > noise)
+            {
+                flag = "  improved";
+            }
+            std::snprintf(line, sizeof line, "%-48s %12.3f %12.3f %+8.1f%%%s\n", r.name.c_str(), b.median_ns,
+                          r.median_ns, 100 * change, flag);
+            os << line;
+        }
+        return regressions;
+    }
+
+} // namespace bench
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+    // Keeps `value` (and everything it points to) alive as far as the optimizer is concerned, without emitting any
+    // instruction. GCC/Clang inline-asm trick; the rest of the repo already relies on GCC/Clang (__PRETTY_FUNCTION__).
+    template <typename T>
+    inline void
+    do_not_optimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template <typename T>
+    inline void
+    do_not_optimize(T &value)
+    {
+#if defined(__clang__)
+        asm volatile("" : "+r,m"(value) : : "memory");
+#else
+        asm volatile("" : "+m,r"(value) : : "memory"); // GCC rejects "+r,m" for some operands
+#endif
+    }
+
+    // Forces pending stores to be treated as observable.
+    inline void
+    clobber_memory()
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    // `body(n)` runs the measured operation n times. One operation processes `items` elements, and the reported
+    // times are per element.
+    struct benchmark
+    {
+        std::string                       name;
+        std::function<void(std::size_t)> body;
+        std::size_t                       items = 1;
+    };
+
+    class registry
+    {
+      public:
+        void
+        add(std::string name, std::function<void(std::size_t)> body, std::size_t items = 1)
+        {
+            benchmarks_.push_back({std::move(name), std::move(body), items});
+        }
+
+        const std::vector<benchmark> &
+        all() const
+        {
+            return benchmarks_;
+        }
+
+      private:
+        std::vector<benchmark> benchmarks_;
+    };
+
+    struct options
+    {
+        std::string filter;              // run only benchmarks whose name contains this
+        int         warmup      = 2;     // untimed repetitions
+        int         repetitions = 11;    // timed repetitions
+        double      min_time_ms = 5;     // every repetition runs at least this long
+        double      threshold   = 0.10;  // relative slowdown that counts as a regression
+        std::string json_path;           // write results here
+        std::string baseline_path;       // compare against a previous JSON file
+    };
+
+    struct result
+    {
+        std::string name;
+        double      median_ns   = 0; // per item
+        double      mad_ns      = 0; // median absolute deviation, per item
+        std::size_t iterations  = 0; // operations per repetition
+        int         repetitions = 0;
+        std::size_t items       = 1;
+    };
+
+    double
+    median(std::vector<double> v);
+
+    // Wall time and peak memory of one child process (fork + execvp + wait4, so POSIX only). wait4 reports the
+    // child's own ru_maxrss, unlike getrusage(RUSAGE_CHILDREN), which is a running maximum over all children.
+    struct process_stats
+    {
+        double ms     = 0;
+        double rss_mb = 0;
+        bool   ok     = false; // exited with status 0
+    };
+
+    process_stats
+    run_process(std::vector<std::string> args);
+
+    // A new, empty directory `parent/prefix.XXXXXX` (mkdtemp) for the files a tool generates. Removing it removes
+    // only what the tool put there, whatever `parent` is. Throws std::filesystem::filesystem_error.
+    std::filesystem::path
+    make_scratch_dir(const std::filesystem::path &parent, const std::string &prefix);
+
+    result
+    run(const benchmark &b, const options &o);
+
+    void
+    write_json(std::ostream &os, const std::vector<result> &results);
+
+    // Reads files produced by write_json (one benchmark object per line). Throws std::runtime_error naming the line
+    // if a number can't be parsed.
+    std::vector<result>
+    read_json(std::istream &is);
+
+    // Prints the comparison and returns the number of regressions: slower by more than `threshold` and by more than
+    // three times the larger of both MADs (so noise alone doesn't count).
+    int
+    compare(const std::vector<result> &current, const std::vector<result> &baseline, double threshold,
+            std::ostream &os);
+
+} // namespace bench
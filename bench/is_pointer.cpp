@@ -0,0 +1,52 @@
+#include <cstddef>
+
+#include "is_pointer.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr std::size_t calls = 1024;
+
+        // one operation = `calls` calls of is_pointer on a pointer and on a non-pointer; all three variants are
+        // resolved at compile time, so they should cost the same as the loop around them.
+        template <typename IsPointer>
+        void
+        add_variant(registry &r, std::string name, IsPointer is_pointer)
+        {
+            r.add(
+                std::move(name),
+                [is_pointer](std::size_t iterations) {
+                    int  value = 0;
+                    int *ptr   = &value;
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        int count = 0;
+                        for (std::size_t i = 0; i < calls; i++)
+                        {
+                            do_not_optimize(ptr);
+                            do_not_optimize(value);
+                            count += is_pointer(ptr) + is_pointer(value);
+                        }
+                        do_not_optimize(count);
+                    }
+                },
+                calls);
+        }
+
+    } // namespace
+
+    void
+    add_is_pointer(registry &r)
+    {
+        add_variant(r, "is_pointer/two_primary_templates",
+                    [](auto x) { return function_templates_cannot_be_partially_specialized_1::is_pointer(x); });
+        // NOTE: not called with void*, whose full specialization prints.
+        add_variant(r, "is_pointer/with_full_specialization",
+                    [](auto x) { return function_templates_cannot_be_partially_specialized_2::is_pointer(x); });
+        add_variant(r, "is_pointer/class_partial_specialization",
+                    [](auto x) { return how_to_partially_specialize_a_function::is_pointer(x); });
+    }
+
+} // namespace bench
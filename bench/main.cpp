@@ -0,0 +1,181 @@
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "harness.hpp"
+#include "suites.hpp"
+
+namespace
+{
+    void
+    usage()
+    {
+        std::cerr << "usage: bench [--list] [--filter=SUBSTR] [--repetitions=N] [--warmup=N] [--min-time-ms=MS]\n"
+                     "             [--json=FILE] [--baseline=FILE] [--threshold=FRACTION]\n";
+    }
+
+    // "--key=value" -> value if the key matches
+    bool
+    option(std::string_view arg, std::string_view key, std::string &value)
+    {
+        if (arg.size() > key.size() && arg.substr(0, key.size()) == key && arg[key.size()] == '=')
+        {
+            value = arg.substr(key.size() + 1);
+            return true;
+        }
+        return false;
+    }
+
+} // namespace
+
+int
+main(int argc, char **argv)
+{
+    bench::options o;
+    bool           list = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        std::string      value;
+        if (arg == "--help")
+        {
+            usage();
+            return 0;
+        }
+        else if (arg == "--list")
+        {
+            list = true;
+        }
+        else if (option(arg, "--filter", value))
+        {
+            o.filter = value;
+        }
+        else if (option(arg, "--repetitions", value))
+        {
+            o.repetitions = std::atoi(value.c_str());
+        }
+        else if (option(arg, "--warmup", value))
+        {
+            o.warmup = std::atoi(value.c_str());
+        }
+        else if (option(arg, "--min-time-ms", value))
+        {
+            o.min_time_ms = std::atof(value.c_str());
+        }
+        else if (option(arg, "--threshold", value))
+        {
+            o.threshold = std::atof(value.c_str());
+        }
+        else if (option(arg, "--json", value))
+        {
+            o.json_path = value;
+        }
+        else if (option(arg, "--baseline", value))
+        {
+            o.baseline_path = value;
+        }
+        else
+        {
+            usage();
+            return 2;
+        }
+    }
+    if (o.repetitions < 1)
+    {
+        usage();
+        return 2;
+    }
+
+    bench::registry r;
+    bench::add_myabs(r);
+    bench::add_advance(r);
+    bench::add_mylist(r);
+    bench::add_tree(r);
+    bench::add_is_pointer(r);
+    bench::add_callables(r);
+    bench::add_counters(r);
+    bench::add_perfect_hash(r);
+    bench::add_allocators(r);
+    bench::add_static_vector(r);
+    bench::add_minmax(r);
+    bench::add_expression(r);
+    bench::add_parallel(r);
+    bench::add_generator(r);
+    bench::add_concurrent(r);
+    bench::add_persistent(r);
+    bench::add_format(r);
+    bench::add_trace(r);
+
+    std::vector<bench::result> results;
+    char                       line[256];
+    if (!list)
+    {
+        std::snprintf(line, sizeof line, "%-48s %12s %10s %12s\n", "benchmark", "ns/item", "MAD", "iterations");
+        std::cout << line;
+    }
+    for (const bench::benchmark &b : r.all())
+    {
+        if (b.name.find(o.filter) == std::string::npos)
+        {
+            continue;
+        }
+        if (list)
+        {
+            std::cout << b.name << '\n';
+            continue;
+        }
+        bench::result res = bench::run(b, o);
+        std::snprintf(line, sizeof line, "%-48s %12.3f %10.3f %12zu\n", res.name.c_str(), res.median_ns, res.mad_ns,
+                      res.iterations);
+        std::cout << line << std::flush;
+        results.push_back(res);
+    }
+    if (list)
+    {
+        return 0;
+    }
+
+    if (!o.json_path.empty())
+    {
+        std::ofstream out(o.json_path);
+        bench::write_json(out, results);
+        if (!out)
+        {
+            std::cerr << "bench: cannot write " << o.json_path << '\n';
+            return 2;
+        }
+    }
+
+    if (!o.baseline_path.empty())
+    {
+        std::ifstream in(o.baseline_path);
+        if (!in)
+        {
+            std::cerr << "bench: cannot read " << o.baseline_path << '\n';
+            return 2;
+        }
+        std::vector<bench::result> baseline;
+        try
+        {
+            baseline = bench::read_json(in);
+        }
+        catch (const std::runtime_error &e)
+        {
+            std::cerr << "bench: bad baseline " << o.baseline_path << ": " << e.what() << '\n';
+            return 2;
+        }
+        int regressions = bench::compare(results, baseline, o.threshold, std::cout);
+        if (regressions > 0)
+        {
+            std::cout << '\n' << regressions << " regression(s) against " << o.baseline_path << '\n';
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minmax.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        // 4096 elements fit in L1/L2 and measure the kernels; 16M elements (16-128 MB) don't fit in the caches and
+        // measure memory bandwidth. Divide sizeof(T) by ns/item for GB/s.
+        constexpr std::size_t small = 4096;
+        constexpr std::size_t large = std::size_t(1) << 24;
+
+        // shared by all benchmarks of one type and size
+        template <typename T>
+        std::shared_ptr<const std::vector<T>>
+        input(std::size_t n)
+        {
+            std::mt19937   gen(42);
+            std::vector<T> v(n);
+            for (T &x : v)
+            {
+                x = static_cast<T>(static_cast<int>(gen() % 2001) - 1000);
+            }
+            return std::make_shared<const std::vector<T>>(std::move(v));
+        }
+
+        template <typename T, typename Reduce>
+        void
+        add_reduction(registry &r, const std::string &name, std::shared_ptr<const std::vector<T>> v, Reduce reduce)
+        {
+            std::size_t n = v->size();
+            r.add(
+                name,
+                [v = std::move(v), reduce](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        do_not_optimize(v->data());
+                        auto result = reduce(*v);
+                        do_not_optimize(result);
+                    }
+                },
+                n);
+        }
+
+        template <typename T>
+        void
+        add_type(registry &r, const std::string &type)
+        {
+            using function_templates::detail::isa;
+
+            for (std::size_t n : {small, large})
+            {
+                std::string prefix = "minmax/" + type + "/" + (n == small ? "4K" : "16M") + "/";
+                auto        v      = input<T>(n);
+
+                add_reduction<T>(r, prefix + "std::minmax_element", v, [](const std::vector<T> &v) {
+                    auto [lo, hi] = std::minmax_element(v.begin(), v.end());
+                    return *lo + *hi;
+                });
+                add_reduction<T>(r, prefix + "std::min_element", v,
+                                 [](const std::vector<T> &v) { return std::min_element(v.begin(), v.end()); });
+
+                // the kernels at each level the CPU supports
+                struct level
+                {
+                    const char *name;
+                    isa         level;
+                };
+                for (level l : {level{"scalar", isa::scalar}, level{"sse2", isa::sse2}, level{"avx2", isa::avx2},
+                                level{"avx512", isa::avx512}})
+                {
+                    if (l.level > function_templates::detail::best_isa())
+                    {
+                        continue;
+                    }
+                    add_reduction<T>(r, prefix + "minmax/" + l.name, v, [lvl = l.level](const std::vector<T> &v) {
+                        auto [lo, hi] = extrema::detail::minmax_kernel(lvl, v.data(), v.size());
+                        return lo + hi;
+                    });
+                }
+                add_reduction<T>(r, prefix + "argmin", v, [](const std::vector<T> &v) { return extrema::argmin(v); });
+            }
+        }
+
+    } // namespace
+
+    void
+    add_minmax(registry &r)
+    {
+        add_type<std::int8_t>(r, "int8");
+        add_type<std::int32_t>(r, "int32");
+        add_type<std::uint64_t>(r, "uint64");
+        add_type<float>(r, "float");
+        add_type<double>(r, "double");
+    }
+
+} // namespace bench
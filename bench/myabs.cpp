@@ -0,0 +1,104 @@
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "myabs.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr std::size_t n = 4096; // fits in L1/L2: measures the kernels, not memory bandwidth
+
+        template <typename T>
+        std::vector<T>
+        signed_input()
+        {
+            std::mt19937   gen(42);
+            std::vector<T> v(n);
+            for (T &x : v)
+            {
+                x = static_cast<T>(static_cast<int>(gen() % 2001) - 1000);
+            }
+            return v;
+        }
+
+        template <typename T>
+        void
+        add_type(registry &r, const std::string &type)
+        {
+            using namespace function_templates;
+            using detail::isa;
+
+            // the scalar template in a plain loop (the compiler may still auto-vectorize it)
+            r.add(
+                "myabs/" + type + "/scalar_template",
+                [in = signed_input<T>(), out = std::vector<T>(n)](std::size_t iterations) mutable {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        for (std::size_t i = 0; i < n; i++)
+                        {
+                            out[i] = myabs(in[i]);
+                        }
+                        do_not_optimize(out.data());
+                        clobber_memory();
+                    }
+                },
+                n);
+
+            struct level
+            {
+                const char *name;
+                isa         level;
+            };
+            for (level l : {level{"scalar_tail", isa::scalar}, level{"sse2", isa::sse2}, level{"avx2", isa::avx2},
+                            level{"avx512", isa::avx512}})
+            {
+                if (l.level > detail::best_isa())
+                {
+                    continue;
+                }
+                r.add(
+                    "myabs/" + type + "/" + l.name,
+                    [in = signed_input<T>(), out = std::vector<T>(n), lvl = l.level](std::size_t iterations) mutable {
+                        for (std::size_t it = 0; it < iterations; it++)
+                        {
+                            detail::myabs_kernel(lvl, in.data(), out.data(), n);
+                            do_not_optimize(out.data());
+                            clobber_memory();
+                        }
+                    },
+                    n);
+            }
+
+            // public batch entry point (runtime dispatch included)
+            r.add(
+                "myabs/" + type + "/batch",
+                [in = signed_input<T>(), out = std::vector<T>(n)](std::size_t iterations) mutable {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        myabs<T>(std::span<const T>(in), std::span<T>(out));
+                        do_not_optimize(out.data());
+                        clobber_memory();
+                    }
+                },
+                n);
+        }
+
+    } // namespace
+
+    void
+    add_myabs(registry &r)
+    {
+        add_type<std::int8_t>(r, "int8");
+        add_type<std::int32_t>(r, "int32");
+        add_type<std::int64_t>(r, "int64");
+        add_type<float>(r, "float");
+        add_type<double>(r, "double");
+    }
+
+} // namespace bench
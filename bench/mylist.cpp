@@ -0,0 +1,274 @@
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mylist.hpp"
+#include "segmented.hpp"
+#include "suites.hpp"
+#include "tree.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr int size = 1 << 16;
+
+        template <typename Container>
+        Container
+        filled()
+        {
+            Container c;
+            for (int i = 0; i < size; i++)
+            {
+                c.push_back(i);
+            }
+            return c;
+        }
+
+        // one operation = summing all elements with a range-for
+        template <typename Container>
+        void
+        add_sum(registry &r, std::string name)
+        {
+            r.add(
+                std::move(name),
+                [c = filled<Container>()](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        long sum = 0;
+                        for (int x : c)
+                        {
+                            sum += x;
+                        }
+                        do_not_optimize(sum);
+                    }
+                },
+                size);
+        }
+
+        // one operation = building the whole container with push_back
+        template <typename Container>
+        void
+        add_push_back(registry &r, std::string name)
+        {
+            r.add(
+                std::move(name),
+                [](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        Container c = filled<Container>();
+                        do_not_optimize(c);
+                    }
+                },
+                size);
+        }
+
+        // one operation = copying a filled container, then inserting size / 8 elements while walking an iterator
+        // through it (one insertion before every 8th element)
+        template <typename Container>
+        void
+        add_insert_walk(registry &r, std::string name)
+        {
+            r.add(
+                std::move(name),
+                [filled = filled<Container>()](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        Container c   = filled;
+                        auto      pos = c.begin();
+                        for (int i = 0; i < size; i += 8)
+                        {
+                            pos = c.insert(pos, i);
+                            std::advance(pos, 9);
+                        }
+                        do_not_optimize(c);
+                    }
+                },
+                size);
+        }
+
+        // The segment-aware algorithms of segmented.hpp against the std:: ones on the same iterators. One operation
+        // is one pass over all segmented_size elements; find looks for a value that isn't there.
+        constexpr int segmented_size = 1 << 20;
+
+        struct std_algorithms
+        {
+            static constexpr const char *name = "std";
+
+            template <typename Iter, typename F>
+            static F
+            for_each(Iter first, Iter last, F f)
+            {
+                return std::for_each(first, last, std::move(f));
+            }
+
+            template <typename Iter, typename T>
+            static Iter
+            find(Iter first, Iter last, const T &value)
+            {
+                return std::find(first, last, value);
+            }
+
+            template <typename InIter, typename OutIter>
+            static OutIter
+            copy(InIter first, InIter last, OutIter d_first)
+            {
+                return std::copy(first, last, d_first);
+            }
+
+            template <typename Iter, typename T>
+            static void
+            fill(Iter first, Iter last, const T &value)
+            {
+                std::fill(first, last, value);
+            }
+        };
+
+        struct segmented_algorithms
+        {
+            static constexpr const char *name = "segmented";
+
+            template <typename Iter, typename F>
+            static F
+            for_each(Iter first, Iter last, F f)
+            {
+                return good_tag_dispatch::for_each(first, last, std::move(f));
+            }
+
+            template <typename Iter, typename T>
+            static Iter
+            find(Iter first, Iter last, const T &value)
+            {
+                return good_tag_dispatch::find(first, last, value);
+            }
+
+            template <typename InIter, typename OutIter>
+            static OutIter
+            copy(InIter first, InIter last, OutIter d_first)
+            {
+                return good_tag_dispatch::copy(first, last, d_first);
+            }
+
+            template <typename Iter, typename T>
+            static void
+            fill(Iter first, Iter last, const T &value)
+            {
+                good_tag_dispatch::fill(first, last, value);
+            }
+        };
+
+        template <typename Container, typename Algorithms>
+        void
+        add_segmented_cases(registry &r, const std::string &container, std::shared_ptr<Container> c)
+        {
+            std::string suffix = std::string("/") + Algorithms::name;
+
+            r.add(
+                "segmented/" + container + "/for_each" + suffix,
+                [c](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        long sum = 0;
+                        Algorithms::for_each(c->begin(), c->end(), [&sum](int x) { sum += x; });
+                        do_not_optimize(sum);
+                    }
+                },
+                segmented_size);
+
+            r.add(
+                "segmented/" + container + "/find" + suffix,
+                [c](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        auto pos = Algorithms::find(c->begin(), c->end(), -1);
+                        do_not_optimize(pos);
+                    }
+                },
+                segmented_size);
+
+            r.add(
+                "segmented/" + container + "/copy" + suffix,
+                [c, out = std::vector<int>(segmented_size)](std::size_t iterations) mutable {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        Algorithms::copy(c->begin(), c->end(), out.begin());
+                        do_not_optimize(out);
+                    }
+                },
+                segmented_size);
+
+            // tree elements are keys and can't be assigned
+            if constexpr (!std::is_const_v<std::remove_reference_t<decltype(*c->begin())>>)
+            {
+                r.add(
+                    "segmented/" + container + "/fill" + suffix,
+                    [c](std::size_t iterations) {
+                        for (std::size_t it = 0; it < iterations; it++)
+                        {
+                            Algorithms::fill(c->begin(), c->end(), static_cast<int>(it));
+                            do_not_optimize(*c);
+                        }
+                    },
+                    segmented_size);
+            }
+        }
+
+        template <typename Container>
+        void
+        add_segmented(registry &r, const std::string &container)
+        {
+            auto c = std::make_shared<Container>();
+            for (int i = 0; i < segmented_size; i++)
+            {
+                if constexpr (requires { c->push_back(i); })
+                {
+                    c->push_back(i);
+                }
+                else
+                {
+                    c->insert(i);
+                }
+            }
+            add_segmented_cases<Container, std_algorithms>(r, container, c);
+            add_segmented_cases<Container, segmented_algorithms>(r, container, c);
+        }
+
+    } // namespace
+
+    void
+    add_mylist(registry &r)
+    {
+        add_sum<class_templates::mylist<int>>(r, "traverse/mylist/range_for");
+        r.add(
+            "traverse/mylist/segmented_for_each",
+            [c = filled<class_templates::mylist<int>>()](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; it++)
+                {
+                    long sum = 0;
+                    good_tag_dispatch::for_each(c.begin(), c.end(), [&sum](int x) { sum += x; });
+                    do_not_optimize(sum);
+                }
+            },
+            size);
+        add_segmented<class_templates::mylist<int>>(r, "mylist<int>");
+        add_segmented<class_templates::mylist<int, 26>>(r, "mylist<int, 26>");
+        add_segmented<class_templates::mylist<int, 60>>(r, "mylist<int, 60>");
+        add_segmented<good_tag_dispatch::tree<int>>(r, "tree<int>");
+        add_sum<std::list<int>>(r, "traverse/std::list/range_for");
+        add_sum<std::vector<int>>(r, "traverse/std::vector/range_for");
+
+        add_push_back<class_templates::mylist<int>>(r, "push_back/mylist");
+        add_push_back<std::list<int>>(r, "push_back/std::list");
+        add_push_back<std::vector<int>>(r, "push_back/std::vector");
+
+        add_insert_walk<class_templates::mylist<int>>(r, "insert_walk/mylist");
+        add_insert_walk<std::list<int>>(r, "insert_walk/std::list");
+        add_insert_walk<std::vector<int>>(r, "insert_walk/std::vector");
+    }
+
+} // namespace bench
@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "mylist.hpp"
+#include "parallel.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr std::size_t n = std::size_t(1) << 22;
+
+        // 1, 2, 4, ... up to the number of hardware threads, which is always included
+        std::vector<std::size_t>
+        thread_counts()
+        {
+            std::size_t              cores = std::max(1u, std::thread::hardware_concurrency());
+            std::vector<std::size_t> counts;
+            for (std::size_t t = 1; t < cores; t *= 2)
+            {
+                counts.push_back(t);
+            }
+            counts.push_back(cores);
+            return counts;
+        }
+
+        // enough arithmetic per element that the memory bandwidth is not the limit
+        double
+        heavy(double x)
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                x = std::sqrt(x * x + 1.0);
+            }
+            return x;
+        }
+
+        // one benchmark per thread count; body(pool, iterations)
+        template <typename Body>
+        void
+        add_scaling(registry &r, const std::string &name, std::size_t items, Body body)
+        {
+            for (std::size_t threads : thread_counts())
+            {
+                auto pool = std::make_shared<parallel::thread_pool>(threads);
+                r.add(
+                    name + "/threads:" + std::to_string(threads),
+                    [pool, body](std::size_t iterations) {
+                        for (std::size_t it = 0; it < iterations; it++)
+                        {
+                            body(*pool);
+                            clobber_memory();
+                        }
+                    },
+                    items);
+            }
+        }
+
+    } // namespace
+
+    void
+    add_parallel(registry &r)
+    {
+        static std::vector<double> in(n, 1.5), out(n);
+
+        // transform_reduce: sum of heavy(x)
+        r.add(
+            "parallel/transform_reduce/std",
+            [](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; it++)
+                {
+                    double s = std::transform_reduce(in.begin(), in.end(), 0.0, std::plus<>{}, heavy);
+                    do_not_optimize(s);
+                }
+            },
+            n);
+        add_scaling(r, "parallel/transform_reduce", n, [](parallel::thread_pool &pool) {
+            double s = parallel::transform_reduce(pool, in.begin(), in.end(), 0.0, std::plus<>{}, heavy);
+            do_not_optimize(s);
+        });
+
+        // transform: memory bound, one read and one write per element
+        r.add(
+            "parallel/transform/std",
+            [](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; it++)
+                {
+                    std::transform(in.begin(), in.end(), out.begin(), [](double x) { return x * 2; });
+                    clobber_memory();
+                }
+            },
+            n);
+        add_scaling(r, "parallel/transform", n, [](parallel::thread_pool &pool) {
+            parallel::transform(pool, in.begin(), in.end(), out.begin(), [](double x) { return x * 2; });
+        });
+
+        // inclusive_scan: two passes, so it needs 2 threads to break even with std::inclusive_scan
+        r.add(
+            "parallel/inclusive_scan/std",
+            [](std::size_t iterations) {
+                for (std::size_t it = 0; it < iterations; it++)
+                {
+                    std::inclusive_scan(in.begin(), in.end(), out.begin());
+                    clobber_memory();
+                }
+            },
+            n);
+        add_scaling(r, "parallel/inclusive_scan", n, [](parallel::thread_pool &pool) {
+            parallel::inclusive_scan(pool, in.begin(), in.end(), out.begin());
+        });
+
+        // for_each over mylist: no random access, so the chunked traversal
+        static class_templates::mylist<double> list = [] {
+            class_templates::mylist<double> l;
+            for (std::size_t i = 0; i < n / 16; i++)
+            {
+                l.push_back(1.5);
+            }
+            return l;
+        }();
+        add_scaling(r, "parallel/for_each_mylist", n / 16, [](parallel::thread_pool &pool) {
+            parallel::for_each(pool, list.begin(), list.end(), [](double &x) { x = heavy(x) - 1.0; });
+        });
+
+        // the cost of one fork-join level: a split of two empty halves
+        add_scaling(r, "parallel/join_overhead", 1, [](parallel::thread_pool &pool) {
+            pool.run([&] { pool.join([] {}, [] {}); });
+        });
+    }
+
+} // namespace bench
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "perfect_hash.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        // a command table of typical size: 64 short names
+        constexpr std::pair<std::string_view, int> entries[] = {
+            {"add", 0},       {"sub", 1},      {"mul", 2},       {"div", 3},       {"mod", 4},       {"neg", 5},
+            {"abs", 6},       {"min", 7},      {"max", 8},       {"and", 9},       {"or", 10},       {"xor", 11},
+            {"not", 12},      {"shl", 13},     {"shr", 14},      {"rol", 15},      {"ror", 16},      {"push", 17},
+            {"pop", 18},      {"dup", 19},     {"swap", 20},     {"over", 21},     {"rot", 22},      {"drop", 23},
+            {"load", 24},     {"store", 25},   {"fetch", 26},    {"call", 27},     {"ret", 28},      {"jmp", 29},
+            {"jz", 30},       {"jnz", 31},     {"cmp", 32},      {"test", 33},     {"halt", 34},     {"nop", 35},
+            {"print", 36},    {"read", 37},    {"write", 38},    {"open", 39},     {"close", 40},    {"seek", 41},
+            {"tell", 42},     {"flush", 43},   {"sync", 44},     {"stat", 45},     {"mkdir", 46},    {"rmdir", 47},
+            {"rename", 48},   {"unlink", 49},  {"link", 50},     {"chmod", 51},    {"chown", 52},    {"time", 53},
+            {"sleep", 54},    {"spawn", 55},   {"wait", 56},     {"kill", 57},     {"signal", 58},   {"exit", 59},
+            {"alloc", 60},    {"free", 61},    {"resize", 62},   {"version", 63},
+        };
+
+        constexpr auto perfect = perfect_hash::make_map(entries);
+
+        constexpr auto sorted = [] {
+            std::array<std::pair<std::string_view, int>, std::size(entries)> a{};
+            std::copy(std::begin(entries), std::end(entries), a.begin());
+            std::sort(a.begin(), a.end());
+            return a;
+        }();
+
+        // one operation = one lookup of every key, in table order
+        template <typename Lookup>
+        void
+        add_lookup(registry &r, std::string name, Lookup lookup)
+        {
+            r.add(
+                std::move(name),
+                [lookup](std::size_t iterations) {
+                    int sum = 0;
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        for (const auto &e : entries)
+                        {
+                            std::string_view key = e.first;
+                            do_not_optimize(key);
+                            sum += lookup(key);
+                        }
+                    }
+                    do_not_optimize(sum);
+                },
+                std::size(entries));
+        }
+
+    } // namespace
+
+    void
+    add_perfect_hash(registry &r)
+    {
+        static const std::unordered_map<std::string_view, int> unordered(std::begin(entries), std::end(entries));
+
+        add_lookup(r, "perfect_hash/lookup/std::unordered_map", [](std::string_view key) {
+            return unordered.find(key)->second;
+        });
+        add_lookup(r, "perfect_hash/lookup/sorted_array", [](std::string_view key) {
+            return std::lower_bound(sorted.begin(), sorted.end(), key,
+                                    [](const auto &e, std::string_view k) { return e.first < k; })
+                ->second;
+        });
+        add_lookup(r, "perfect_hash/lookup/perfect_hash::map", [](std::string_view key) {
+            return *perfect.find(key);
+        });
+    }
+
+} // namespace bench
@@ -0,0 +1,133 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "persistent.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        // Startup cost of getting a myvec<double> back from disk (from the page cache: the files were just written):
+        //
+        //   text     std::ifstream >> one double at a time (the usual stream deserializer)
+        //   read     persistent::read: the binary file copied into a new vector
+        //   map      persistent::mapped: open + mmap + header check, nothing touched
+        //   map_sum  the same, then every element read once (page faults included)
+        //
+        // Items are elements, so ns/item of `map` shrinks with the size while the others stay flat.
+        struct files
+        {
+            std::filesystem::path binary, text;
+            std::size_t           n;
+
+            explicit files(std::size_t n_) : n(n_)
+            {
+                auto dir = std::filesystem::temp_directory_path();
+                binary   = dir / ("bench_persistent_" + std::to_string(n) + ".myvec");
+                text     = dir / ("bench_persistent_" + std::to_string(n) + ".txt");
+            }
+
+            files(const files &) = delete;
+            files &
+            operator=(const files &) = delete;
+
+            ~files()
+            {
+                std::error_code ec;
+                std::filesystem::remove(binary, ec);
+                std::filesystem::remove(text, ec);
+            }
+
+            // on the first call, i.e. during calibration
+            void
+            ensure()
+            {
+                if (written)
+                {
+                    return;
+                }
+                std::mt19937                           gen(42);
+                std::uniform_real_distribution<double> dist(-1000, 1000);
+                std::vector<double>                    v(n);
+                for (double &x : v)
+                {
+                    x = dist(gen);
+                }
+                persistent::save(binary.string(), v);
+                std::ofstream out(text);
+                out.precision(17);
+                out << n << '\n';
+                for (double x : v)
+                {
+                    out << x << '\n';
+                }
+                written = true;
+            }
+
+          private:
+            bool written = false;
+        };
+
+        std::vector<double>
+        read_text(const std::string &path)
+        {
+            std::ifstream       in(path);
+            std::size_t         n = 0;
+            in >> n;
+            std::vector<double> v(n);
+            for (double &x : v)
+            {
+                in >> x;
+            }
+            return v;
+        }
+
+        template <typename Load>
+        void
+        add_loader(registry &r, const std::string &name, std::shared_ptr<files> f, Load load)
+        {
+            std::size_t n = f->n;
+            r.add(
+                "persistent/" + name + "/" + std::to_string(n),
+                [f = std::move(f), load](std::size_t iterations) {
+                    f->ensure();
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        auto result = load(*f);
+                        do_not_optimize(result);
+                        clobber_memory();
+                    }
+                },
+                n);
+        }
+
+    } // namespace
+
+    void
+    add_persistent(registry &r)
+    {
+        for (std::size_t n : {std::size_t(4096), std::size_t(1) << 20})
+        {
+            auto f = std::make_shared<files>(n);
+            add_loader(r, "text", f, [](const files &f) { return read_text(f.text.string()).size(); });
+            add_loader(r, "read", f, [](const files &f) { return persistent::read<double>(f.binary.string())[0]; });
+            add_loader(r, "map", f, [](const files &f) { return persistent::mapped<double>(f.binary.string())[0]; });
+            add_loader(r, "map_sum", f, [](const files &f) {
+                persistent::mapped<double> m(f.binary.string());
+                double                     sum = 0;
+                for (double x : m)
+                {
+                    sum += x;
+                }
+                return sum;
+            });
+        }
+    }
+
+} // namespace bench
@@ -0,0 +1,84 @@
+#include <cstddef>
+#include <vector>
+
+#include "static_vector.hpp"
+#include "suites.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        constexpr std::size_t length = 8;
+
+        // std::vector that allocates its final size up front: one allocation instead of four
+        struct reserved_vector : std::vector<int>
+        {
+            reserved_vector()
+            {
+                reserve(length);
+            }
+        };
+
+        // one operation = build a vector of `length` ints by push_back, read it back, destroy it
+        template <typename Vector>
+        void
+        add_build(registry &r, std::string name)
+        {
+            r.add(
+                std::move(name),
+                [](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        Vector v;
+                        for (std::size_t i = 0; i < length; i++)
+                        {
+                            v.push_back(int(i));
+                        }
+                        do_not_optimize(v);
+                        int sum = 0;
+                        for (int x : v)
+                        {
+                            sum += x;
+                        }
+                        do_not_optimize(sum);
+                    }
+                },
+                length);
+        }
+
+        // one operation = copy a vector of `length` ints (and destroy the copy)
+        template <typename Vector>
+        void
+        add_copy(registry &r, std::string name)
+        {
+            r.add(
+                std::move(name),
+                [](std::size_t iterations) {
+                    Vector source;
+                    for (std::size_t i = 0; i < length; i++)
+                    {
+                        source.push_back(int(i));
+                    }
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        do_not_optimize(source);
+                        Vector copy = source;
+                        do_not_optimize(copy);
+                    }
+                },
+                length);
+        }
+
+    } // namespace
+
+    void
+    add_static_vector(registry &r)
+    {
+        add_build<std::vector<int>>(r, "static_vector/build_8/std::vector");
+        add_build<reserved_vector>(r, "static_vector/build_8/std::vector+reserve");
+        add_build<class_templates::static_vector<int, length>>(r, "static_vector/build_8/static_vector");
+        add_copy<std::vector<int>>(r, "static_vector/copy_8/std::vector");
+        add_copy<class_templates::static_vector<int, length>>(r, "static_vector/copy_8/static_vector");
+    }
+
+} // namespace bench
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "harness.hpp"
+
+namespace bench
+{
+    // One function per suite (bench/<suite>.cpp); main() adds them all to the registry.
+
+    void
+    add_myabs(registry &r);
+
+    void
+    add_advance(registry &r);
+
+    void
+    add_mylist(registry &r);
+
+    void
+    add_tree(registry &r);
+
+    void
+    add_is_pointer(registry &r);
+
+    void
+    add_callables(registry &r);
+
+    void
+    add_counters(registry &r);
+
+    void
+    add_perfect_hash(registry &r);
+
+    void
+    add_allocators(registry &r);
+
+    void
+    add_static_vector(registry &r);
+
+    void
+    add_minmax(registry &r);
+
+    void
+    add_expression(registry &r);
+
+    void
+    add_parallel(registry &r);
+
+    void
+    add_generator(registry &r);
+
+    void
+    add_concurrent(registry &r);
+
+    void
+    add_persistent(registry &r);
+
+    void
+    add_format(registry &r);
+
+    void
+    add_trace(registry &r);
+
+} // namespace bench
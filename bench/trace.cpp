@@ -0,0 +1,85 @@
+#include <chrono>
+#include <cstddef>
+
+#include "suites.hpp"
+#include "trace.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        // The cost of one traced scope around an empty body:
+        //
+        //   macro         TRACE_SCOPE as this build compiles it (nothing, unless built with TRACING=1)
+        //   scope         a tracing::scope, i.e. what TRACE_SCOPE costs with TRACING=1
+        //   steady_clock  two std::chrono::steady_clock::now(), for comparison
+        //   now           two tracing::now() (rdtsc on x86)
+        void
+        traced_scope()
+        {
+            tracing::scope s("bench");
+            clobber_memory();
+        }
+
+        void
+        traced_macro()
+        {
+            TRACE_SCOPE("bench");
+            clobber_memory();
+        }
+
+    } // namespace
+
+    void
+    add_trace(registry &r)
+    {
+        r.add(
+            "trace/macro",
+            [](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    traced_macro();
+                }
+            },
+            1);
+
+        r.add(
+            "trace/scope",
+            [](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    traced_scope();
+                }
+            },
+            1);
+
+        r.add(
+            "trace/steady_clock",
+            [](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    auto begin = std::chrono::steady_clock::now();
+                    clobber_memory();
+                    auto end = std::chrono::steady_clock::now();
+                    do_not_optimize(begin);
+                    do_not_optimize(end);
+                }
+            },
+            1);
+
+        r.add(
+            "trace/now",
+            [](std::size_t iterations) {
+                for (std::size_t i = 0; i < iterations; i++)
+                {
+                    auto begin = tracing::now();
+                    clobber_memory();
+                    auto end = tracing::now();
+                    do_not_optimize(begin);
+                    do_not_optimize(end);
+                }
+            },
+            1);
+    }
+
+} // namespace bench
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "suites.hpp"
+#include "tree.hpp"
+
+namespace bench
+{
+    namespace
+    {
+        // good_tag_dispatch::tree<int> (a B+ tree) against std::map<int, int> on the same random keys
+
+        using tree_type = good_tag_dispatch::tree<int>;
+        using map_type  = std::map<int, int>;
+
+        std::vector<int>
+        random_keys(int n)
+        {
+            std::mt19937     gen(11);
+            std::vector<int> keys(static_cast<std::size_t>(n));
+            for (int &k : keys)
+            {
+                k = static_cast<int>(gen());
+            }
+            return keys;
+        }
+
+        void
+        insert_key(tree_type &t, int k)
+        {
+            t.insert(k);
+        }
+
+        void
+        insert_key(map_type &m, int k)
+        {
+            m.emplace(k, k);
+        }
+
+        int
+        key(int k)
+        {
+            return k;
+        }
+
+        int
+        key(const map_type::value_type &kv)
+        {
+            return kv.first;
+        }
+
+        template <typename Container>
+        Container
+        filled(const std::vector<int> &keys)
+        {
+            Container c;
+            for (int k : keys)
+            {
+                insert_key(c, k);
+            }
+            return c;
+        }
+
+        // per size: insert = building the container from all keys, find = one lookup of a present key,
+        // iterate = one full in-order traversal
+        template <typename Container>
+        void
+        add_cases(registry &r, const std::string &suffix, const std::vector<int> &keys)
+        {
+            r.add(
+                "tree/insert/" + suffix,
+                [&keys](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        Container c = filled<Container>(keys);
+                        do_not_optimize(c);
+                    }
+                },
+                keys.size());
+
+            // the lookup order is shuffled, so successive finds don't walk the same path
+            std::vector<int> lookups = keys;
+            std::shuffle(lookups.begin(), lookups.end(), std::mt19937(13));
+            r.add("tree/find/" + suffix,
+                  [c = filled<Container>(keys), lookups = std::move(lookups)](std::size_t iterations) {
+                      for (std::size_t it = 0; it < iterations; it++)
+                      {
+                          auto pos = c.find(lookups[it % lookups.size()]);
+                          do_not_optimize(pos);
+                      }
+                  });
+
+            Container   c = filled<Container>(keys);
+            std::size_t n = c.size(); // random keys may repeat
+            r.add(
+                "tree/iterate/" + suffix,
+                [c = std::move(c)](std::size_t iterations) {
+                    for (std::size_t it = 0; it < iterations; it++)
+                    {
+                        long sum = 0;
+                        for (const auto &x : c)
+                        {
+                            sum += key(x);
+                        }
+                        do_not_optimize(sum);
+                    }
+                },
+                n);
+        }
+
+    } // namespace
+
+    void
+    add_tree(registry &r)
+    {
+        static std::map<int, std::vector<int>> keys; // the insert cases refer to these; outlive the registry
+        for (int n : {1 << 10, 1 << 16, 1 << 20})
+        {
+            const std::vector<int> &k    = keys[n] = random_keys(n);
+            std::string             size = n == 1 << 10 ? "1K" : n == 1 << 16 ? "64K" : "1M";
+            add_cases<tree_type>(r, size + "/tree", k);
+            add_cases<map_type>(r, size + "/std::map", k);
+        }
+    }
+
+} // namespace bench
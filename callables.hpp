@@ -0,0 +1,272 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace callables
+{
+    // Type-erased callables for callback parameters that never allocate:
+    //
+    //   function_ref<R(A...)>           non-owning: an object pointer plus a call thunk, two words, trivially copyable.
+    //                                   Refers to the callable it was built from, so it must not outlive it (fine
+    //                                   for parameters; a temporary lambda lives until the end of the full call).
+    //   inplace_function<R(A...), N>    owning: copies the callable into N bytes inside the object. A callable
+    //                                   that doesn't fit is a compile error, never a heap allocation. Its moves
+    //                                   are noexcept, so the callable's move constructor must not throw either.
+    //
+    // Both accept capturing lambdas. Like std::function they have deduction guides, so the signature can be deduced
+    // from a function pointer or a lambda: `function_ref([k](double x) { return int(x) * k; })` is a
+    // function_ref<int(double)>.
+
+    namespace detail
+    {
+        // signature of a non-generic, non-overloaded operator()
+        template <typename MemberPointer>
+        struct call_signature;
+
+        template <typename R, typename G, typename... A>
+        struct call_signature<R (G::*)(A...)>
+        {
+            using type = R(A...);
+        };
+
+        template <typename R, typename G, typename... A>
+        struct call_signature<R (G::*)(A...) const>
+        {
+            using type = R(A...);
+        };
+
+        template <typename R, typename G, typename... A>
+        struct call_signature<R (G::*)(A...) noexcept>
+        {
+            using type = R(A...);
+        };
+
+        template <typename R, typename G, typename... A>
+        struct call_signature<R (G::*)(A...) const noexcept>
+        {
+            using type = R(A...);
+        };
+
+        template <typename F>
+        using call_signature_t = typename call_signature<decltype(&F::operator())>::type;
+
+        template <typename F, typename R, typename... A>
+        R
+        invoke_as(F &f, A... args)
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                std::invoke(f, std::forward<A>(args)...);
+            }
+            else
+            {
+                return std::invoke(f, std::forward<A>(args)...);
+            }
+        }
+
+    } // namespace detail
+
+    // function_ref
+
+    template <typename Signature>
+    class function_ref;
+
+    template <typename R, typename... A>
+    class function_ref<R(A...)>
+    {
+      public:
+        // function pointers (and functions, which decay): stored by value, so `function_ref(+lambda)` doesn't
+        // refer to a dead temporary pointer
+        template <typename F>
+            requires std::is_function_v<F> && std::is_invocable_r_v<R, F &, A...>
+        function_ref(F *f) noexcept
+            : bound_{.fn = reinterpret_cast<void (*)()>(f)}, call_(&call_function<F>)
+        {
+        }
+
+        // everything else that is callable: stored by address
+        template <typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, function_ref> &&
+                     !std::is_pointer_v<std::remove_cvref_t<F>> && !std::is_function_v<std::remove_cvref_t<F>> &&
+                     std::is_invocable_r_v<R, std::remove_reference_t<F> &, A...>)
+        function_ref(F &&f) noexcept
+            : bound_{.object = const_cast<void *>(static_cast<const void *>(std::addressof(f)))},
+              call_(&call_object<std::remove_reference_t<F>>)
+        {
+        }
+
+        R
+        operator()(A... args) const
+        {
+            return call_(bound_, std::forward<A>(args)...);
+        }
+
+      private:
+        union bound
+        {
+            void *object;
+            void (*fn)();
+        };
+
+        template <typename F>
+        static R
+        call_object(bound b, A... args)
+        {
+            return detail::invoke_as<F, R, A...>(*static_cast<F *>(b.object), std::forward<A>(args)...);
+        }
+
+        template <typename F>
+        static R
+        call_function(bound b, A... args)
+        {
+            return detail::invoke_as<F, R, A...>(*reinterpret_cast<F *>(b.fn), std::forward<A>(args)...);
+        }
+
+        bound bound_;
+        R (*call_)(bound, A...);
+    };
+
+    template <typename R, typename... A>
+    function_ref(R (*)(A...)) -> function_ref<R(A...)>;
+
+    template <typename F>
+    function_ref(F &&) -> function_ref<detail::call_signature_t<std::remove_cvref_t<F>>>;
+
+    // inplace_function
+
+    template <typename Signature, std::size_t Capacity = 4 * sizeof(void *),
+              std::size_t Alignment = alignof(std::max_align_t)>
+    class inplace_function;
+
+    template <typename R, typename... A, std::size_t Capacity, std::size_t Alignment>
+    class inplace_function<R(A...), Capacity, Alignment>
+    {
+      public:
+        inplace_function() noexcept
+            : ops_(&empty_ops)
+        {
+        }
+
+        inplace_function(std::nullptr_t) noexcept
+            : ops_(&empty_ops)
+        {
+        }
+
+        template <typename F>
+            requires(!std::is_same_v<std::remove_cvref_t<F>, inplace_function> &&
+                     std::is_copy_constructible_v<std::decay_t<F>> &&
+                     std::is_nothrow_move_constructible_v<std::decay_t<F>> &&
+                     std::is_invocable_r_v<R, std::decay_t<F> &, A...>)
+        inplace_function(F &&f)
+            : ops_(&ops_for<std::decay_t<F>>)
+        {
+            using T = std::decay_t<F>;
+            static_assert(sizeof(T) <= Capacity, "callable too large for this inplace_function: raise Capacity");
+            static_assert(alignof(T) <= Alignment, "callable over-aligned for this inplace_function");
+            ::new (static_cast<void *>(storage_)) T(std::forward<F>(f));
+        }
+
+        inplace_function(const inplace_function &other)
+            : ops_(other.ops_)
+        {
+            ops_->copy(storage_, other.storage_);
+        }
+
+        // leaves `other` empty
+        inplace_function(inplace_function &&other) noexcept
+            : ops_(other.ops_)
+        {
+            ops_->move(storage_, other.storage_);
+            other.ops_ = &empty_ops;
+        }
+
+        inplace_function &
+        operator=(const inplace_function &other)
+        {
+            if (this != &other)
+            {
+                inplace_function copy(other);
+                *this = std::move(copy);
+            }
+            return *this;
+        }
+
+        inplace_function &
+        operator=(inplace_function &&other) noexcept
+        {
+            if (this != &other)
+            {
+                ops_->destroy(storage_);
+                ops_ = other.ops_;
+                ops_->move(storage_, other.storage_);
+                other.ops_ = &empty_ops;
+            }
+            return *this;
+        }
+
+        ~inplace_function()
+        {
+            ops_->destroy(storage_);
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return ops_ != &empty_ops;
+        }
+
+        // throws std::bad_function_call when empty, like std::function
+        R
+        operator()(A... args) const
+        {
+            return ops_->call(const_cast<std::byte *>(storage_), std::forward<A>(args)...);
+        }
+
+      private:
+        // one static table per stored type instead of virtual functions, so the object is just storage plus a pointer
+        struct ops
+        {
+            R (*call)(std::byte *, A...);
+            void (*copy)(std::byte *, const std::byte *);
+            void (*move)(std::byte *, std::byte *); // move-constructs into dst and destroys src
+            void (*destroy)(std::byte *);
+        };
+
+        template <typename T>
+        static constexpr ops ops_for = {
+            [](std::byte *s, A... args) -> R {
+                return detail::invoke_as<T, R, A...>(*std::launder(reinterpret_cast<T *>(s)), std::forward<A>(args)...);
+            },
+            [](std::byte *dst, const std::byte *src) {
+                ::new (static_cast<void *>(dst)) T(*std::launder(reinterpret_cast<const T *>(src)));
+            },
+            [](std::byte *dst, std::byte *src) {
+                T *from = std::launder(reinterpret_cast<T *>(src));
+                ::new (static_cast<void *>(dst)) T(std::move(*from));
+                from->~T();
+            },
+            [](std::byte *s) { std::launder(reinterpret_cast<T *>(s))->~T(); },
+        };
+
+        static constexpr ops empty_ops = {
+            [](std::byte *, A...) -> R { throw std::bad_function_call(); },
+            [](std::byte *, const std::byte *) {},
+            [](std::byte *, std::byte *) {},
+            [](std::byte *) {},
+        };
+
+        const ops *ops_;
+        alignas(Alignment) std::byte storage_[Capacity];
+    };
+
+    template <typename R, typename... A>
+    inplace_function(R (*)(A...)) -> inplace_function<R(A...)>;
+
+    template <typename F>
+    inplace_function(F) -> inplace_function<detail::call_signature_t<F>>;
+
+} // namespace callables
@@ -0,0 +1,424 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace concurrent
+{
+    // Lock-free containers to share between threads, built from the node mylist<T> started out as:
+    // { T data; node *next; } (see mylist.hpp):
+    //
+    //   stack<T>    Treiber stack: push/pop are one CAS on the head
+    //   queue<T>    Michael-Scott queue: push CASes the last node's next (then swings the tail), pop the head
+    //
+    // Both take any number of producers and consumers; try_pop() returns std::nullopt when empty.
+    //
+    // A popped node can't be deleted right away: another thread may have read the pointer just before and be about
+    // to look at node->next. Nodes are therefore retired to epoch-based reclamation (Fraser): every operation runs
+    // inside an epoch::guard, and a node retired in epoch e is deleted once the global epoch has reached e + 2, i.e.
+    // once every thread that might have seen it has left its operation. This also rules out ABA on the head: a
+    // node can't be reused while anybody who read it is still inside a guard.
+    //
+    // (The unrolled nodes of today's mylist hold several elements, which a single CAS can't update.)
+
+    namespace epoch
+    {
+        // Every thread that has ever entered a guard owns one record (reused after the thread exits). The
+        // epoch's low bit says whether the thread is inside a guard.
+        struct alignas(64) record
+        {
+            struct retired
+            {
+                void         *p;
+                void        (*destroy)(void *);
+                std::uint64_t epoch;
+            };
+
+            std::atomic<std::uint64_t> local{0};
+            std::atomic<bool>          in_use{true};
+            record                    *next = nullptr;
+
+            // owner only
+            unsigned            depth   = 0; // nested guards
+            unsigned            retires = 0; // since the last attempt to advance the epoch
+            std::deque<retired> limbo;       // in retirement order, i.e. by epoch
+        };
+
+        class domain
+        {
+          public:
+            static domain &
+            global()
+            {
+                static domain d;
+                return d;
+            }
+
+            domain() = default;
+
+            domain(const domain &) = delete;
+            domain &
+            operator=(const domain &) = delete;
+
+            // at exit, with no other thread left inside a guard
+            ~domain()
+            {
+                for (record *r = records_.load(); r;)
+                {
+                    record *next = r->next;
+                    for (auto &g : r->limbo)
+                    {
+                        g.destroy(g.p);
+                    }
+                    delete r;
+                    r = next;
+                }
+            }
+
+            void
+            enter(record &r)
+            {
+                if (r.depth++ > 0)
+                {
+                    return;
+                }
+                // A seq_cst RMW: the announcement is visible before this thread reads any shared pointer, and it
+                // releases what the thread wrote before (try_advance acquires it).
+                std::uint64_t e = epoch_.load(std::memory_order_acquire);
+                r.local.exchange(e << 1 | 1, std::memory_order_seq_cst);
+                collect(r, epoch_.load(std::memory_order_acquire));
+            }
+
+            void
+            leave(record &r)
+            {
+                if (--r.depth == 0)
+                {
+                    r.local.store(0, std::memory_order_release);
+                }
+            }
+
+            // p, already unreachable from the shared structure, is passed to destroy once nobody can hold it
+            void
+            retire(record &r, void *p, void (*destroy)(void *))
+            {
+                r.limbo.push_back({p, destroy, epoch_.load(std::memory_order_seq_cst)});
+                if (++r.retires >= 64)
+                {
+                    r.retires = 0;
+                    try_advance();
+                    collect(r, epoch_.load(std::memory_order_acquire));
+                }
+            }
+
+            record &
+            acquire()
+            {
+                for (record *r = records_.load(std::memory_order_acquire); r; r = r->next)
+                {
+                    bool free = false;
+                    if (!r->in_use.load(std::memory_order_relaxed) &&
+                        r->in_use.compare_exchange_strong(free, true, std::memory_order_acquire))
+                    {
+                        return *r;
+                    }
+                }
+                record *r = new record;
+                r->next   = records_.load(std::memory_order_relaxed);
+                while (!records_.compare_exchange_weak(r->next, r, std::memory_order_release,
+                                                       std::memory_order_relaxed))
+                {
+                }
+                return *r;
+            }
+
+            // what is left in the limbo list goes to the next thread that takes the record
+            void
+            release(record &r)
+            {
+                r.in_use.store(false, std::memory_order_release);
+            }
+
+          private:
+            // The epoch moves on only once every thread inside a guard has seen the current one.
+            void
+            try_advance()
+            {
+                std::uint64_t e = epoch_.load(std::memory_order_seq_cst);
+                for (record *r = records_.load(std::memory_order_acquire); r; r = r->next)
+                {
+                    std::uint64_t local = r->local.load(std::memory_order_seq_cst);
+                    if ((local & 1) && (local >> 1) != e)
+                    {
+                        return;
+                    }
+                }
+                epoch_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+            }
+
+            static void
+            collect(record &r, std::uint64_t e)
+            {
+                while (!r.limbo.empty() && r.limbo.front().epoch + 2 <= e)
+                {
+                    auto g = r.limbo.front();
+                    r.limbo.pop_front();
+                    g.destroy(g.p);
+                }
+            }
+
+            std::atomic<std::uint64_t> epoch_{0};
+            std::atomic<record *>      records_{nullptr};
+        };
+
+        namespace detail
+        {
+            // the calling thread's record, taken on first use and given back at thread exit
+            struct owner
+            {
+                record *r = nullptr;
+
+                ~owner()
+                {
+                    if (r)
+                    {
+                        domain::global().release(*r);
+                    }
+                }
+            };
+
+            inline record &
+            this_thread()
+            {
+                static thread_local owner o;
+                if (!o.r) [[unlikely]]
+                {
+                    o.r = &domain::global().acquire();
+                }
+                return *o.r;
+            }
+
+        } // namespace detail
+
+        // Pointers read from a shared structure stay valid while the guard that was alive when they were read is.
+        class guard
+        {
+          public:
+            guard() : r_(detail::this_thread())
+            {
+                domain::global().enter(r_);
+            }
+
+            guard(const guard &) = delete;
+            guard &
+            operator=(const guard &) = delete;
+
+            ~guard()
+            {
+                domain::global().leave(r_);
+            }
+
+            template <typename T>
+            void
+            retire(T *p)
+            {
+                domain::global().retire(r_, p, [](void *q) { delete static_cast<T *>(q); });
+            }
+
+          private:
+            record &r_;
+        };
+
+    } // namespace epoch
+
+    template <typename T>
+    class stack
+    {
+      public:
+        stack() = default;
+
+        stack(const stack &) = delete;
+        stack &
+        operator=(const stack &) = delete;
+
+        // not concurrently with anything else
+        ~stack()
+        {
+            for (node *n = head_.load(std::memory_order_relaxed); n;)
+            {
+                node *next = n->next;
+                delete n;
+                n = next;
+            }
+        }
+
+        void
+        push(T value)
+        {
+            node *n = new node{std::move(value), head_.load(std::memory_order_relaxed)};
+            while (!head_.compare_exchange_weak(n->next, n, std::memory_order_release, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        std::optional<T>
+        try_pop()
+        {
+            epoch::guard g;
+            node        *h = head_.load(std::memory_order_acquire);
+            while (h && !head_.compare_exchange_weak(h, h->next, std::memory_order_acquire, std::memory_order_acquire))
+            {
+            }
+            if (!h)
+            {
+                return std::nullopt;
+            }
+            std::optional<T> value(std::move(h->data)); // h is ours now: only its `next` is still read by others
+            g.retire(h);
+            return value;
+        }
+
+        // a snapshot, already stale when it returns
+        bool
+        empty() const
+        {
+            return head_.load(std::memory_order_acquire) == nullptr;
+        }
+
+      private:
+        struct node
+        {
+            T     data;
+            node *next;
+        };
+
+        alignas(64) std::atomic<node *> head_{nullptr};
+    };
+
+    template <typename T>
+    class queue
+    {
+      public:
+        queue()
+        {
+            node *dummy = new node;
+            head_.store(dummy, std::memory_order_relaxed);
+            tail_.store(dummy, std::memory_order_relaxed);
+        }
+
+        queue(const queue &) = delete;
+        queue &
+        operator=(const queue &) = delete;
+
+        // not concurrently with anything else
+        ~queue()
+        {
+            node *n    = head_.load(std::memory_order_relaxed);
+            node *next = n->next.load(std::memory_order_relaxed);
+            delete n; // the dummy holds no element
+            for (n = next; n; n = next)
+            {
+                next = n->next.load(std::memory_order_relaxed);
+                std::destroy_at(n->data());
+                delete n;
+            }
+        }
+
+        void
+        push(T value)
+        {
+            node *n = new node;
+            ::new (static_cast<void *>(n->storage)) T(std::move(value));
+
+            epoch::guard g;
+            while (true)
+            {
+                node *t    = tail_.load(std::memory_order_acquire);
+                node *next = t->next.load(std::memory_order_acquire);
+                if (t != tail_.load(std::memory_order_acquire))
+                {
+                    continue;
+                }
+                if (next == nullptr)
+                {
+                    if (t->next.compare_exchange_weak(next, n, std::memory_order_release, std::memory_order_relaxed))
+                    {
+                        tail_.compare_exchange_strong(t, n, std::memory_order_release, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+                else
+                {
+                    // the tail lags behind: help the other push finish
+                    tail_.compare_exchange_weak(t, next, std::memory_order_release, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // The first node is a dummy; popping makes the node after it (whose element is taken) the new dummy.
+        std::optional<T>
+        try_pop()
+        {
+            epoch::guard g;
+            while (true)
+            {
+                node *h    = head_.load(std::memory_order_acquire);
+                node *t    = tail_.load(std::memory_order_acquire);
+                node *next = h->next.load(std::memory_order_acquire);
+                if (h != head_.load(std::memory_order_acquire))
+                {
+                    continue;
+                }
+                if (next == nullptr)
+                {
+                    return std::nullopt;
+                }
+                if (h == t)
+                {
+                    tail_.compare_exchange_weak(t, next, std::memory_order_release, std::memory_order_relaxed);
+                    continue;
+                }
+                if (head_.compare_exchange_weak(h, next, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    // next's element is ours; next itself stays as the dummy
+                    std::optional<T> value(std::move(*next->data()));
+                    std::destroy_at(next->data());
+                    g.retire(h);
+                    return value;
+                }
+            }
+        }
+
+        // a snapshot, already stale when it returns
+        bool
+        empty() const
+        {
+            epoch::guard g;
+            return head_.load(std::memory_order_acquire)->next.load(std::memory_order_acquire) == nullptr;
+        }
+
+      private:
+        struct node
+        {
+            std::atomic<node *> next{nullptr};
+            alignas(T) unsigned char storage[sizeof(T)];
+
+            T *
+            data()
+            {
+                return std::launder(reinterpret_cast<T *>(storage));
+            }
+        };
+
+        // on separate cache lines: producers hit the tail, consumers the head
+        alignas(64) std::atomic<node *> head_;
+        alignas(64) std::atomic<node *> tail_;
+    };
+
+} // namespace concurrent
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cxxabi.h>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace counters
+{
+    // Per-type instrumentation built on template_classes_are_still_classes: ST<T>::sdm is a separate variable for
+    // every T. counter<T>::add() therefore goes straight to counter<T>'s own storage, with no map lookup and no
+    // registration call on the hot path.
+    //
+    //   counter<T>::add(n = 1)           count events
+    //   histogram<T>::record(value)      power-of-two buckets (bucket b holds values with bit_width == b)
+    //   timer<T> t;                      records its lifetime in ns into histogram<timer<T>>
+    //   snapshot()                       sums the shards of every metric used so far, sorted by name
+    //
+    // Every metric has `shards` cache-line sized slots. A thread always uses the same slot (threads are assigned
+    // round-robin), so threads don't share cache lines unless there are more threads than shards. Updates are
+    // relaxed atomics: a snapshot taken while other threads count is not a consistent cut, but nothing is lost.
+
+    inline constexpr std::size_t shards  = 16;
+    inline constexpr std::size_t buckets = 65; // bit_width of a uint64_t is 0..64
+
+    enum class kind
+    {
+        counter,
+        histogram,
+    };
+
+    struct entry
+    {
+        std::string                name; // demangled T
+        kind                       k;
+        std::uint64_t              count = 0;
+        std::uint64_t              sum   = 0; // histograms only
+        std::vector<std::uint64_t> histogram; // `buckets` entries, histograms only
+    };
+
+    namespace detail
+    {
+        // shard + 1, 0 until the thread's first update. Constant-initialized, so reading it needs no TLS guard.
+        inline thread_local std::size_t shard_plus_one = 0;
+
+        inline std::size_t
+        shard_index()
+        {
+            if (shard_plus_one == 0) [[unlikely]]
+            {
+                static std::atomic<std::size_t> next{0};
+                shard_plus_one = next.fetch_add(1, std::memory_order_relaxed) % shards + 1;
+            }
+            return shard_plus_one - 1;
+        }
+
+        template <typename T>
+        std::string
+        type_name()
+        {
+            int                                    status = 0;
+            std::unique_ptr<char, void (*)(void *)> name(
+                abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status), std::free);
+            return status == 0 ? name.get() : typeid(T).name();
+        }
+
+        struct alignas(64) counter_shard
+        {
+            std::atomic<std::uint64_t> count{0};
+        };
+
+        struct alignas(64) histogram_shard
+        {
+            std::atomic<std::uint64_t> count{0};
+            std::atomic<std::uint64_t> sum{0};
+            std::atomic<std::uint64_t> histogram[buckets]{};
+        };
+
+        // One entry per instantiated metric, added while its `registered` member is initialized (dynamic
+        // initialization, before main). Function-local statics, so the registry exists before the first metric
+        // whatever the initialization order of the translation units.
+        struct metric
+        {
+            entry (*read)();
+        };
+
+        inline std::mutex &
+        registry_mutex()
+        {
+            static std::mutex m;
+            return m;
+        }
+
+        inline std::vector<metric> &
+        registry()
+        {
+            static std::vector<metric> r;
+            return r;
+        }
+
+        inline bool
+        add_metric(entry (*read)())
+        {
+            std::lock_guard lock(registry_mutex());
+            registry().push_back({read});
+            return true;
+        }
+
+    } // namespace detail
+
+    template <typename T>
+    struct counter
+    {
+        static void
+        add(std::uint64_t n = 1)
+        {
+            (void)registered;
+            storage[detail::shard_index()].count.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        static std::uint64_t
+        value()
+        {
+            std::uint64_t total = 0;
+            for (const auto &s : storage)
+            {
+                total += s.count.load(std::memory_order_relaxed);
+            }
+            return total;
+        }
+
+        static entry
+        read()
+        {
+            return {detail::type_name<T>(), kind::counter, value(), 0, {}};
+        }
+
+        // static data members of a class template: one set per T
+        static inline detail::counter_shard storage[shards];
+        static inline const bool            registered = detail::add_metric(&read);
+    };
+
+    template <typename T>
+    struct histogram
+    {
+        static void
+        record(std::uint64_t value)
+        {
+            (void)registered;
+            auto &s = storage[detail::shard_index()];
+            s.count.fetch_add(1, std::memory_order_relaxed);
+            s.sum.fetch_add(value, std::memory_order_relaxed);
+            s.histogram[std::bit_width(value)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static entry
+        read()
+        {
+            entry e{detail::type_name<T>(), kind::histogram, 0, 0, std::vector<std::uint64_t>(buckets)};
+            for (const auto &s : storage)
+            {
+                e.count += s.count.load(std::memory_order_relaxed);
+                e.sum += s.sum.load(std::memory_order_relaxed);
+                for (std::size_t b = 0; b < buckets; b++)
+                {
+                    e.histogram[b] += s.histogram[b].load(std::memory_order_relaxed);
+                }
+            }
+            return e;
+        }
+
+        static inline detail::histogram_shard storage[shards];
+        static inline const bool              registered = detail::add_metric(&read);
+    };
+
+    template <typename T>
+    class timer
+    {
+      public:
+        timer() : start_(std::chrono::steady_clock::now())
+        {
+        }
+
+        timer(const timer &) = delete;
+        timer &
+        operator=(const timer &) = delete;
+
+        ~timer()
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+            histogram<timer>::record(static_cast<std::uint64_t>(ns.count()));
+        }
+
+      private:
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    inline std::vector<entry>
+    snapshot()
+    {
+        std::vector<detail::metric> metrics;
+        {
+            std::lock_guard lock(detail::registry_mutex());
+            metrics = detail::registry();
+        }
+        std::vector<entry> entries;
+        for (const auto &m : metrics)
+        {
+            entries.push_back(m.read());
+        }
+        std::sort(entries.begin(), entries.end(), [](const entry &a, const entry &b) { return a.name < b.name; });
+        return entries;
+    }
+
+    // One line per metric; histograms add their mean and the non-empty buckets as "[lo, hi): n".
+    inline void
+    print(std::ostream &os, const std::vector<entry> &entries)
+    {
+        for (const auto &e : entries)
+        {
+            os << e.name << ": " << e.count;
+            if (e.k == kind::histogram)
+            {
+                os << " (mean " << (e.count ? e.sum / e.count : 0) << ')';
+                for (std::size_t b = 0; b < buckets; b++)
+                {
+                    if (e.histogram[b])
+                    {
+                        std::uint64_t lo = b ? std::uint64_t(1) << (b - 1) : 0;
+                        os << " [" << lo << ", ";
+                        if (b < 64)
+                        {
+                            os << (std::uint64_t(1) << b);
+                        }
+                        else
+                        {
+                            os << "2^64";
+                        }
+                        os << "): " << e.histogram[b];
+                    }
+                }
+            }
+            os << '\n';
+        }
+    }
+
+} // namespace counters
@@ -0,0 +1,366 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "myabs.hpp" // function_templates::detail::best_isa() and myabs_wrap()
+#include "trace.hpp" // TRACE_SCOPE
+
+namespace expression_templates
+{
+    // Lazy element-wise arithmetic over alias_templates::myvec (any std::vector<T, A>, whatever the allocator policy):
+    //
+    //   myvec<double> r = a + b * c - abs(d);   // one loop, no temporary vectors
+    //   assign(r, a + b * c - abs(d));          // the same, into r's existing storage (any element type)
+    //
+    // `a + b * c - abs(d)` only builds a small tree of views (two pointers and a size per vector) whose operator[]
+    // computes one element. Evaluating it is a single loop over the whole tree, compiled for the widest vector unit
+    // the CPU has (picked at run time, like the batch myabs), which the compiler can vectorize as one fused kernel.
+    //
+    // Operands are vectors, expressions, and arithmetic scalars (broadcast to every element). Mixed element types
+    // follow the scalar rules of how_to_call_a_specialization_explicitly::add<T, U>: the operation is done in, and
+    // yields, std::common_type_t<T, U> (int + double is double, float * 2 stays float). abs is function_templates'
+    // myabs: it wraps on the minimum of a signed integer.
+    //
+    // All vector operands must have the same size (std::length_error otherwise). The tree refers to its vectors, so
+    // it must not outlive them: evaluate it in the full-expression that builds it rather than keeping it in an
+    // `auto`. The destination may be one of the operands, since element i only reads element i.
+    //
+    // The operators are not found by ADL for two plain vectors (their namespace is std), so bring them into scope
+    // with `using namespace expression_templates;`.
+
+    namespace detail
+    {
+        // base of every node, so the operators can recognize them
+        struct node
+        {
+        };
+
+        // the size of an expression without a vector operand
+        constexpr std::size_t unsized = std::size_t(-1);
+
+        template <typename T, typename A, typename E>
+        void
+        assign(std::vector<T, A> &v, const E &e);
+
+        // base of the operation nodes: converts to a vector of its value_type, which evaluates it
+        template <typename Derived>
+        struct evaluable : node
+        {
+            template <typename T, typename A>
+                requires std::is_same_v<T, typename Derived::value_type>
+            operator std::vector<T, A>() const
+            {
+                std::vector<T, A> v;
+                assign(v, static_cast<const Derived &>(*this));
+                return v;
+            }
+        };
+
+        // a vector operand, seen as a read-only view
+        template <typename T>
+        struct terminal : node
+        {
+            using value_type = T;
+
+            const T    *data;
+            std::size_t count;
+
+            [[gnu::always_inline]] T
+            operator[](std::size_t i) const
+            {
+                return data[i];
+            }
+
+            std::size_t
+            size() const
+            {
+                return count;
+            }
+        };
+
+        // a scalar operand; it has no size of its own and matches any
+        template <typename T>
+        struct scalar : node
+        {
+            using value_type = T;
+
+            T value;
+
+            [[gnu::always_inline]] T
+            operator[](std::size_t) const
+            {
+                return value;
+            }
+
+            static constexpr std::size_t
+            size()
+            {
+                return unsized;
+            }
+        };
+
+        template <typename L, typename R>
+        std::size_t
+        common_size(const L &l, const R &r)
+        {
+            std::size_t n = l.size(), m = r.size();
+            if (n != unsized && m != unsized && n != m)
+            {
+                throw std::length_error("expression_templates: operands have different sizes");
+            }
+            return n != unsized ? n : m;
+        }
+
+        template <typename Op, typename L, typename R>
+        struct binary : evaluable<binary<Op, L, R>>
+        {
+            using value_type = std::common_type_t<typename L::value_type, typename R::value_type>;
+
+            L           l;
+            R           r;
+            std::size_t count;
+
+            binary(L l_, R r_) : l(l_), r(r_), count(common_size(l_, r_))
+            {
+            }
+
+            [[gnu::always_inline]] value_type
+            operator[](std::size_t i) const
+            {
+                return static_cast<value_type>(Op{}(static_cast<value_type>(l[i]), static_cast<value_type>(r[i])));
+            }
+
+            std::size_t
+            size() const
+            {
+                return count;
+            }
+        };
+
+        template <typename Op, typename E>
+        struct unary : evaluable<unary<Op, E>>
+        {
+            using value_type = typename E::value_type;
+
+            E e;
+
+            [[gnu::always_inline]] value_type
+            operator[](std::size_t i) const
+            {
+                return static_cast<value_type>(Op{}(e[i]));
+            }
+
+            std::size_t
+            size() const
+            {
+                return e.size();
+            }
+        };
+
+        struct absolute
+        {
+            template <typename T>
+            [[gnu::always_inline]] T
+            operator()(T x) const
+            {
+                return function_templates::detail::myabs_wrap(x);
+            }
+        };
+
+        // argument type -> node type: vectors become terminals, scalars become scalar nodes, nodes stay as they are
+        template <typename X>
+        struct to_node
+        {
+        };
+
+        template <typename T, typename A>
+            requires std::is_arithmetic_v<T>
+        struct to_node<std::vector<T, A>>
+        {
+            using type = terminal<T>;
+
+            static type
+            make(const std::vector<T, A> &v)
+            {
+                return {{}, v.data(), v.size()};
+            }
+        };
+
+        template <typename T>
+            requires std::is_arithmetic_v<T>
+        struct to_node<T>
+        {
+            using type = scalar<T>;
+
+            static type
+            make(T x)
+            {
+                return {{}, x};
+            }
+        };
+
+        template <typename E>
+            requires std::is_base_of_v<node, E>
+        struct to_node<E>
+        {
+            using type = E;
+
+            static const E &
+            make(const E &e)
+            {
+                return e;
+            }
+        };
+
+        template <typename X>
+        concept operand = requires { typename to_node<X>::type; };
+
+        // at least one side must be a vector or an expression: 1 + 2 stays plain arithmetic
+        template <typename L, typename R>
+        concept operands = operand<L> && operand<R> && !(std::is_arithmetic_v<L> && std::is_arithmetic_v<R>);
+
+        template <typename X>
+        using node_t = typename to_node<X>::type;
+
+        template <typename Op, typename L, typename R>
+        binary<Op, node_t<L>, node_t<R>>
+        make_binary(const L &l, const R &r)
+        {
+            return {to_node<L>::make(l), to_node<R>::make(r)};
+        }
+
+        // The evaluation loop, always inlined into the per-ISA wrappers below (whose target attribute decides the
+        // instructions), and through it the whole tree.
+        template <typename T, typename E>
+        [[gnu::always_inline]] inline void
+        store(T *out, const E &e, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                out[i] = static_cast<T>(e[i]);
+            }
+        }
+
+        template <typename T, typename E>
+        void
+        store_scalar(T *out, const E &e, std::size_t n)
+        {
+            store(out, e, n);
+        }
+
+#if MYABS_X86
+        template <typename T, typename E>
+        __attribute__((target("avx2"))) void
+        store_avx2(T *out, const E &e, std::size_t n)
+        {
+            store(out, e, n);
+        }
+
+        template <typename T, typename E>
+        __attribute__((target("avx512f,avx512bw"))) void
+        store_avx512(T *out, const E &e, std::size_t n)
+        {
+            store(out, e, n);
+        }
+#endif
+
+        template <typename T, typename E>
+        void
+        store_kernel(function_templates::detail::isa level, T *out, const E &e, std::size_t n)
+        {
+            using function_templates::detail::isa;
+#if MYABS_X86
+            if (level == isa::avx512)
+            {
+                return store_avx512(out, e, n);
+            }
+            else if (level == isa::avx2)
+            {
+                return store_avx2(out, e, n);
+            }
+#else
+            (void)level;
+#endif
+            store_scalar(out, e, n); // SSE2 is the x86-64 baseline
+        }
+
+        template <typename T, typename A, typename E>
+        void
+        assign(std::vector<T, A> &v, const E &e)
+        {
+            std::size_t n = e.size();
+            if (n == unsized)
+            {
+                throw std::length_error("expression_templates: expression has no vector operand");
+            }
+            TRACE_SCOPE("expression_templates::assign");
+            v.resize(n);
+            store_kernel(function_templates::detail::best_isa(), v.data(), e, n);
+        }
+
+    } // namespace detail
+
+    template <typename E>
+    concept expression = std::is_base_of_v<detail::node, E> && !std::is_same_v<E, detail::node>;
+
+    // Evaluates e into v, resized to e's size. v's element type need not be e's (each element is converted).
+    template <typename T, typename A, expression E>
+    void
+    assign(std::vector<T, A> &v, const E &e)
+    {
+        detail::assign(v, e);
+    }
+
+    template <typename L, typename R>
+        requires detail::operands<L, R>
+    auto
+    operator+(const L &l, const R &r)
+    {
+        return detail::make_binary<std::plus<>>(l, r);
+    }
+
+    template <typename L, typename R>
+        requires detail::operands<L, R>
+    auto
+    operator-(const L &l, const R &r)
+    {
+        return detail::make_binary<std::minus<>>(l, r);
+    }
+
+    template <typename L, typename R>
+        requires detail::operands<L, R>
+    auto
+    operator*(const L &l, const R &r)
+    {
+        return detail::make_binary<std::multiplies<>>(l, r);
+    }
+
+    template <typename L, typename R>
+        requires detail::operands<L, R>
+    auto
+    operator/(const L &l, const R &r)
+    {
+        return detail::make_binary<std::divides<>>(l, r);
+    }
+
+    template <typename X>
+        requires detail::operand<X> && (!std::is_arithmetic_v<X>)
+    detail::unary<std::negate<>, detail::node_t<X>>
+    operator-(const X &x)
+    {
+        return {{}, detail::to_node<X>::make(x)};
+    }
+
+    template <typename X>
+        requires detail::operand<X> && (!std::is_arithmetic_v<X>)
+    detail::unary<detail::absolute, detail::node_t<X>>
+    abs(const X &x)
+    {
+        return {{}, detail::to_node<X>::make(x)};
+    }
+
+} // namespace expression_templates
@@ -1,10 +1,41 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
+#include "abs_policy.hpp"
+#include "advance.hpp"
+#include "allocators.hpp"
+#include "callables.hpp"
+#include "concurrent.hpp"
+#include "counters.hpp"
+#include "expression.hpp"
+#include "format.hpp"
+#include "generator.hpp"
+#include "instantiations.hpp"
+#include "is_pointer.hpp"
+#include "minmax.hpp"
+#include "myabs.hpp"
+#include "mylist.hpp"
+#include "parallel.hpp"
+#include "perfect_hash.hpp"
+#include "persistent.hpp"
+#include "sections.hpp"
+#include "segmented.hpp"
+#include "static_vector.hpp"
+#include "tree.hpp"
+#include "type_name.hpp"
+#include "typelist.hpp"
+
 namespace function_overloading
 {
     int
@@ -56,30 +87,9 @@ namespace motivation
 
 } // namespace motivation
 
-namespace function_templates
-{
-    // Templates are cookie cutters.
-    // You don't pay for what you don't use.
+// namespace function_templates: see myabs.hpp (scalar `myabs` plus the batch forms over ranges)
 
-    template <typename T>
-    T
-    myabs(T x)
-    {
-        return (x >= 0) ? x : -x;
-    }
-
-} // namespace function_templates
-
-namespace class_templates
-{
-    template <typename T>
-    struct mylist
-    {
-        T          data;
-        mylist<T> *next;
-    };
-
-} // namespace class_templates
+// namespace class_templates: see mylist.hpp (unrolled, cache-line sized nodes with a recycling freelist)
 
 namespace template_classes_are_still_classes
 {
@@ -138,8 +148,9 @@ namespace alias_templates
     using myvec_double = std::vector<double>;
 
     // but not here
-    template <typename T>
-    using myvec = std::vector<T>;
+    // The allocator is chosen by a policy (see allocators.hpp); the default keeps myvec<T> = std::vector<T>.
+    template <typename T, typename Policy = allocators::policy::heap>
+    using myvec = std::vector<T, allocators::allocator_t<Policy, T>>;
 
 } // namespace alias_templates
 
@@ -181,21 +192,21 @@ namespace rules_of_template_type_deduction
     void
     foo(T)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
     template <typename T, typename U>
     void
     f(T, U)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << ", U = " << type_names::type_name<U>() << std::endl;
     };
 
     template <typename T>
     void
     g(T, T)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     };
 
 } // namespace rules_of_template_type_deduction
@@ -208,7 +219,7 @@ namespace puzzle_1
         std::array<U, sizeof(T)>, //
         int)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << ", U = " << type_names::type_name<U>() << std::endl;
     }
 
 } // namespace puzzle_1
@@ -219,7 +230,16 @@ namespace puzzle_2
     void
     foo(R (*)(A))
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "R = " << type_names::type_name<R>() << ", A = " << type_names::type_name<A>() << std::endl;
+    }
+
+    // Same deduction for any callable, capturing lambdas included: function_ref's deduction guide recovers the
+    // signature from the lambda's operator(), then R and A are deduced from function_ref<R(A)>. No heap.
+    template <typename R, typename A>
+    void
+    foo(callables::function_ref<R(A)>)
+    {
+        std::cout << "R = " << type_names::type_name<R>() << ", A = " << type_names::type_name<A>() << std::endl;
     }
 
 } // namespace puzzle_2
@@ -240,7 +260,7 @@ namespace how_to_call_a_specialization_explicitly
     T
     abs(T x)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
         return (x >= 0) ? x : -x;
     }
 
@@ -248,7 +268,7 @@ namespace how_to_call_a_specialization_explicitly
     void
     add(T, U)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << ", U = " << type_names::type_name<U>() << std::endl;
     }
 
 } // namespace how_to_call_a_specialization_explicitly
@@ -259,7 +279,7 @@ namespace default_template_parameters
     void
     add()
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
 } // namespace default_template_parameters
@@ -271,7 +291,7 @@ namespace template_type_deduction_real_deal_1
     void
     f(T)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
     // pointer
@@ -279,7 +299,7 @@ namespace template_type_deduction_real_deal_1
     void
     f(T *)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
 } // namespace template_type_deduction_real_deal_1
@@ -291,7 +311,7 @@ namespace template_type_deduction_real_deal_2
     void
     f(T &)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
 } // namespace template_type_deduction_real_deal_2
@@ -303,7 +323,7 @@ namespace template_type_deduction_real_deal_3
     void
     f(T &&) // can only be a reference (either r-value or l-value reference - && or &)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
 } // namespace template_type_deduction_real_deal_3
@@ -314,7 +334,7 @@ namespace case_in_which_refref_is_deduced
     void
     f(void (*)(T))
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
     void
@@ -330,7 +350,7 @@ namespace reference_and_cv_collapsing
     void
     f(T &&)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
 } // namespace reference_and_cv_collapsing
@@ -341,7 +361,7 @@ namespace deducing_Tref_not_Trefref
     void
     f(T &)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
 } // namespace deducing_Tref_not_Trefref
@@ -352,7 +372,7 @@ namespace rvalues_are_kinda_like_const_lvalues
     void
     f(T &)
     {
-        puts(__PRETTY_FUNCTION__);
+        std::cout << "T = " << type_names::type_name<T>() << std::endl;
     }
 
 } // namespace rvalues_are_kinda_like_const_lvalues
@@ -397,8 +417,30 @@ namespace defining_a_template_specialization_2
         return (x >= 0) ? x : -x;
     }
 
+    // See abs_policy.hpp for making the reaction to overflow a template parameter (throw, saturate, wrap, ...).
+
 } // namespace defining_a_template_specialization_2
 
+namespace specializing_a_library_template
+{
+    struct fraction
+    {
+        int num, den;
+    };
+
+} // namespace specializing_a_library_template
+
+// A library's template is specialized in the library's namespace, for our own type.
+template <>
+struct formatting::formatter<specializing_a_library_template::fraction>
+{
+    static void
+    write(buffer &out, const specializing_a_library_template::fraction &f, spec)
+    {
+        format_to(out, "{}/{}", f.num, f.den);
+    }
+};
+
 namespace partial_specialization_1
 {
     template <typename T>
@@ -457,98 +499,8 @@ namespace which_specialization_is_called
 
 } // namespace which_specialization_is_called
 
-namespace function_templates_cannot_be_partially_specialized_1
-{
-    // Function templates cannot be partially specialized!
-    // Only full/explicit specialization allowed !
-
-    template <typename T>
-    bool
-    is_pointer(T)
-    {
-        return false;
-    }
-
-    // this is NOT a partial specialization
-    template <typename T>
-    bool
-    is_pointer(T *)
-    {
-        return true;
-    }
-
-    // Now we have two primary function templates in the same overload set. Dangerous!
-
-} // namespace function_templates_cannot_be_partially_specialized_1
-
-namespace function_templates_cannot_be_partially_specialized_2
-{
-    // Depending where you put the full specialization (after first or second primary function template) you get
-    // possibly different behavior. Dangerous! If you put the full specialization after first primary function template
-    // it will be a specialization for the first primary template. If you put the full specialization after second
-    // primary function template it will be a specialization for the second primary template.
-
-    // 1st primary function template
-    template <typename T>
-    bool
-    is_pointer(T)
-    {
-        return false;
-    }
-
-    // full specialization
-    template <>
-    bool
-    is_pointer(void *)
-    {
-        puts(__PRETTY_FUNCTION__);
-        return true;
-    }
-
-    // 2nd primary function template
-    template <typename T>
-    bool
-    is_pointer(T *)
-    {
-        return true;
-    }
-
-} // namespace function_templates_cannot_be_partially_specialized_2
-
-namespace how_to_partially_specialize_a_function
-{
-    // How to partially specialize a function
-
-    // primary template
-    template <typename T>
-    struct is_pointer_impl
-    {
-        static bool
-        _()
-        {
-            return false;
-        }
-    };
-
-    // partial specialization (classes can be partially specialized!)
-    template <typename T>
-    struct is_pointer_impl<T *>
-    {
-        static bool
-        _()
-        {
-            return true;
-        }
-    };
-
-    template <typename T>
-    bool
-    is_pointer(T)
-    {
-        return is_pointer_impl<T>::_();
-    }
-
-} // namespace how_to_partially_specialize_a_function
+// function_templates_cannot_be_partially_specialized_1/2 and how_to_partially_specialize_a_function:
+// see is_pointer.hpp
 
 // Begin Part 2
 
@@ -602,63 +554,7 @@ namespace bad_tag_dispatch
 
 } // namespace bad_tag_dispatch
 
-namespace good_tag_dispatch
-{
-    template <typename Element>
-    struct tree_iterator
-    {
-        tree_iterator &operator++();
-        using supports_plus = std::false_type;
-    };
-
-    template <typename Element>
-    struct vector_iterator
-    {
-        vector_iterator &operator++();
-        vector_iterator  operator+();
-        using supports_plus = std::true_type;
-    };
-
-    template <typename Element>
-    struct vector
-    {
-        using iterator = vector_iterator<Element>;
-    };
-
-    template <typename Element>
-    struct tree
-    {
-        using iterator = tree_iterator<Element>;
-    };
-
-    template <typename Iter>
-    Iter
-    advance_impl(Iter begin, int n, std::false_type)
-    {
-        for (int i = 0; i < n; i++)
-        {
-            ++begin;
-        }
-        return begin;
-    }
-
-    template <typename Iter>
-    Iter
-    advance_impl(Iter begin, int n, std::true_type)
-    {
-        return begin + n;
-    }
-
-    template <typename Iter>
-    auto
-    advance(Iter begin, int n)
-    {
-        // NOTE: `typename` is not strictly necessary in C++20.
-        // NOTE: We instantiate a value of type Iter::supports_plus (you can use `()` or `{}`). See below.
-        return advance_impl(begin, n, typename Iter::supports_plus());
-    }
-
-} // namespace good_tag_dispatch
+// namespace good_tag_dispatch: see advance.hpp (tag dispatch for advance) and tree.hpp
 
 namespace dependent_names
 {
@@ -716,125 +612,199 @@ namespace refer_to_template
 } // namespace refer_to_template
 
 int
-main()
+main(int argc, char **argv)
 {
     std::cout << std::boolalpha;
 
-    {
+    sections::registry r;
+
+    r.add("Function Overloading", "function_overloading", [] {
         // function overloading (params are significant)
         // Functions that differ only in their return type cannot be overloaded.
 
         using namespace function_overloading;
 
-        std::cout << "=== Function Overloading\n" << std::endl;
-
         f1(42);   // 42
         f1(42.0); // 42
-    }
+    });
 
-    {
+    r.add("Motivation", "motivation", [] {
         // Without templates we need a bunch of overloaded functions
         // and implicit conversions can also be a pain in the ass.
 
         using namespace motivation;
 
-        std::cout << "\n=== Motivation\n" << std::endl;
-
-        std::cout << abs(-42.0) << std::endl; // 42
-        std::cout << abs(-42.f) << std::endl; // 42
+        // NOTE: qualified, because <stdlib.h> (pulled in by the SIMD intrinsics) also puts ::abs overloads in scope.
+        std::cout << motivation::abs(-42.0) << std::endl; // 42
+        std::cout << motivation::abs(-42.f) << std::endl; // 42
 
         // std::cout << abs(-42) << std::endl; // error: Call to 'abs' is ambiguous
-    }
+    });
 
-    {
+    r.add("Using a Function Template", "function_templates", [] {
         using namespace function_templates;
 
-        std::cout << "\n=== Using a Function Template\n" << std::endl;
-
         std::cout << myabs(-42.0) << std::endl;    // 42
         std::cout << myabs<int>(-42) << std::endl; // 42
         std::cout << myabs(-42) << std::endl;      // 42
 
         double (*foo)(double) = myabs<double>;
         std::cout << foo(-42.0) << std::endl;      // 42
-    }
 
-    {
-        using namespace class_templates;
+        // batch form over a contiguous range (SIMD kernels + scalar tail)
+        std::vector<int> v = {-1, 2, -3, 4, -5, 6, -7, 8, -9};
+        myabs(v.begin(), v.end(), v.begin());
+        for (int x : v)
+        {
+            std::cout << x << ' ';
+        }
+        std::cout << std::endl; // 1 2 3 4 5 6 7 8 9
+    });
 
-        std::cout << "\n=== Class Templates\n" << std::endl;
+    r.add("Class Templates", "class_templates", [] {
+        using namespace class_templates;
 
         mylist<int>    *intlist [[maybe_unused]]{};
         mylist<double> *doublelist [[maybe_unused]]{};
-    }
 
-    {
-        using namespace template_classes_are_still_classes;
+        mylist<int> l1 = {1, 2, 3};
+        mylist<int> l2 = {10, 20};
+        l1.push_front(0);
+        l1.emplace_back(4);
+        l1.splice(std::next(l1.begin(), 2), l2); // relinks nodes, no copies
+        for (int x : l1)
+        {
+            std::cout << x << ' ';
+        }
+        std::cout << std::endl; // 0 1 10 20 2 3 4
 
-        std::cout << "\n=== Template Classes are still Classes\n" << std::endl;
+        l1.splice(l1.begin(), l1, std::next(l1.begin(), 5), l1.end()); // within the same list
+        for (int x : l1)
+        {
+            std::cout << x << ' ';
+        }
+        std::cout << std::endl; // 3 4 0 1 10 20 2
+
+        // inserting one of the list's own elements into its full node
+        mylist<std::string, 4> s = {"a", "b", "c", std::string(32, 'd')};
+        s.push_front(s.back());
+        std::cout << s.front().size() << ' ' << s.size() << std::endl; // 32 5
+
+        // to share between threads: lock-free, on single-element nodes
+        concurrent::queue<int> q;
+        std::thread            producer([&] {
+            for (int i = 1; i <= 100; i++)
+            {
+                q.push(i);
+            }
+        });
+
+        int sum = 0;
+        for (int popped = 0; popped < 100;)
+        {
+            if (auto x = q.try_pop())
+            {
+                sum += *x;
+                popped++;
+            }
+        }
+        producer.join();
+        std::cout << sum << std::endl; // 5050
+    });
+
+    r.add("Template Classes are still Classes", "template_classes_are_still_classes", [] {
+        using namespace template_classes_are_still_classes;
 
         std::cout << S::sdm << std::endl;        // 42
         std::cout << ST<char>::sdm << std::endl; // 42
-    }
 
-    {
+        // The same trick keyed by type: counter<T> has its own (sharded) storage for every T.
+        counters::counter<int>::add();
+        counters::counter<int>::add(2);
+        counters::counter<ST<char>>::add();
+        counters::histogram<double>::record(5);
+        counters::histogram<double>::record(100);
+        counters::print(std::cout, counters::snapshot());
+        // double: 2 (mean 52) [4, 8): 1 [64, 128): 1
+        // int: 3
+        // template_classes_are_still_classes::ST<char>: 1
+    });
+
+    r.add("Variable Templates", "variable_templates", [] {
         // Variable templates are syntactic sugar for class templates.
         // A variable template is exactly 100% equivalent to a static data member of a class template.
 
         using namespace variable_templates;
 
-        std::cout << "\n=== Variable Templates\n" << std::endl;
-
         std::cout << is_void<int>::value << std::endl; // false
         std::cout << is_void_v<int> << std::endl;      // false
-    }
 
-    {
-        using namespace best_of_both_worlds;
+        // The same kind of constexpr lookup keyed by a value: the table is computed by the compiler.
+        constexpr auto commands = perfect_hash::make_map<std::string_view, int>({{"push", 1}, {"pop", 2}, {"peek", 3}});
+        static_assert(commands.at("pop") == 2 && !commands.contains("drop"));
+
+        std::string_view command = "peek";
+        std::cout << *commands.find(command) << std::endl; // 3
+    });
 
-        std::cout << "\n=== Best of both worlds in the STL\n" << std::endl;
+    r.add("Best of both worlds in the STL", "best_of_both_worlds", [] {
+        using namespace best_of_both_worlds;
 
         std::cout << is_void<int>::value << std::endl; // false
         std::cout << is_void_v<int> << std::endl;      // false
-    }
+    });
 
-    {
+    r.add("Alias Templates", "alias_templates", [] {
         using namespace alias_templates;
 
-        std::cout << "\n=== Alias Templates\n" << std::endl;
-
         static_assert(std::is_same_v<myvec_double, std::vector<double>>);
         static_assert(std::is_same_v<myvec<double>, std::vector<double>>);
-    }
 
-    {
-        using namespace literally_the_same_type;
+        // request-scoped vectors: all of them are released by one reset() of their arena
+        allocators::arena                        request;
+        myvec<int, allocators::policy::arena>    ids(request);
+        myvec<double, allocators::policy::arena> weights(request);
+        std::pmr::monotonic_buffer_resource      buffer;
+        myvec<int, allocators::policy::pmr>      scratch(&buffer);
+        for (int i = 0; i < 4; i++)
+        {
+            ids.push_back(i);
+            weights.push_back(i / 2.0);
+            scratch.push_back(i * i);
+        }
+        std::cout << ids.size() + weights.size() + scratch.size() << std::endl; // 12
+
+        // lazy arithmetic: one loop, no temporaries; int and double mix as in add<int, double>
+        {
+            using namespace expression_templates;
+
+            myvec<double> w = ids * weights - abs(ids - 2);
+            std::cout << w[0] << " " << w[3] << std::endl; // -2 3.5
+        }
+    });
 
-        std::cout << "\n=== Literally the same type\n" << std::endl;
+    r.add("Literally the same type", "literally_the_same_type", [] {
+        using namespace literally_the_same_type;
 
         int i{};
         f(i); // OK because myint is int
 
         std::vector<int> v = {1, 2, 3, 4};
         g(v); // OK because myvec<int> is std::vector<int>
-    }
+    });
 
-    {
+    r.add("Type Deduction", "type_deduction", [] {
         using namespace type_deduction;
 
-        std::cout << "\n=== Type Deduction\n" << std::endl;
-
         double (*f)(double) = abs<double>;
 
         std::cout << f(-42.0) << std::endl;      // 42
         std::cout << abs<int>(-42) << std::endl; // 42
-    }
+    });
 
-    {
+    r.add("Rules of Template Type Deduction", "rules_of_template_type_deduction", [] {
         using namespace rules_of_template_type_deduction;
 
-        std::cout << "\n=== Rules of Template Type Deduction\n" << std::endl;
-
         foo(4);       // [T = int]
         foo(4.2);     // [T = double]
         foo("hello"); // [T = const char *]
@@ -842,36 +812,46 @@ main()
         f(1, 2);      // [T = int, U = int]
         g(1, 2);      // [T = int]
         // g(1, 2u);  // error: no matching function for call to g(int, unsigned int)
-    }
+    });
 
-    {
+    r.add("Puzzle #1", "puzzle_1", [] {
         using namespace puzzle_1;
 
-        std::cout << "\n=== Puzzle #1\n" << std::endl;
-
         foo(std::array<int, 8>{},    // [T = int; U = double]
             std::array<double, 4>{}, //
             0.0);
 
         // foo(std::array<int, 9>{}, std::array<double, 4>{}, 0.0); // error: No matching function for call to 'foo'
-    }
 
-    {
+        // A compile-time capacity, like std::array<T, sizeof(U)>, but a run-time length.
+        class_templates::static_vector<int, sizeof(double)> v = {1, 2, 3};
+        v.push_back(4);
+        v.erase(v.begin());
+        static_assert(std::is_trivially_copyable_v<decltype(v)>);
+        std::cout << v.size() << '/' << v.capacity() << ' ' << *good_tag_dispatch::advance(v.begin(), 2)
+                  << std::endl; // 3/8 4
+
+        // non-trivial elements: moving a longer vector into a shorter one move-constructs the extra elements
+        class_templates::static_vector<std::string, 4> a = {"x"}, b = {"1", "2", "3"};
+        a = std::move(b);
+        std::cout << a.size() << ' ' << a.front() << a.back() << std::endl; // 3 13
+    });
+
+    r.add("Puzzle #2", "puzzle_2", [] {
         using namespace puzzle_2;
 
-        std::cout << "\n=== Puzzle #2\n" << std::endl;
-
         foo(+[](double x) { return int(x); }); // [with R = int; A = double]
 
         // captureless lambda is always IMPLICITLY convertible to a function pointer.
         // But templates DO NOT use implicit conversions!
         // foo([](double x) { return int(x); }); // error
-    }
 
-    {
-        using namespace how_many_people_have_seen_this;
+        int k = 2;
+        foo(callables::function_ref([k](double x) { return int(x) * k; })); // [with R = int; A = double]
+    });
 
-        std::cout << "\n=== Many People have seen this\n" << std::endl;
+    r.add("Many People have seen this", "how_many_people_have_seen_this", [] {
+        using namespace how_many_people_have_seen_this;
 
         // std::max(f(), 42);                    // error: No matching function for call to 'max'
 
@@ -880,16 +860,24 @@ main()
 
         // make template paarameters explicit
         std::cout << std::max<int>(f(), 24) << std::endl; // 42
-    }
 
-    {
+        // or promote to the common type, comparing signed and unsigned by value
+        std::cout << extrema::max(f(), 24) << std::endl;        // 42
+        std::cout << extrema::min(-1, 1u) << std::endl;         // -1 (std::min<unsigned>(-1, 1u) is 1)
+        std::cout << extrema::clamp(f(), 0u, 10u) << std::endl; // 10
+
+        // vectorized range versions
+        std::vector<float> v = {3.5f, -1.0f, 7.25f, -1.0f};
+        auto [lo, hi]        = extrema::minmax(v);
+        std::cout << lo << ' ' << hi << ' ' << extrema::argmin(v) << std::endl; // -1 7.25 1
+    });
+
+    r.add("Call a Specialization explicitly", "how_to_call_a_specialization_explicitly", [] {
         using namespace how_to_call_a_specialization_explicitly;
 
         // template parameters in angle brackets, <...>.
         // function parameters in round brackets, (...).
 
-        std::cout << "\n=== Call a Specialization explicitly\n" << std::endl;
-
         std::cout << abs<int>('x') << std::endl;  // [T = int]    | 120
         std::cout << abs<double>(3) << std::endl; // [T = double] | 3
 
@@ -897,42 +885,34 @@ main()
         add<int>('x', 3.1);                       // [T = int, U = double]
         add<>('x', 3.1);                          // [T = char, U = double]
         add('x', 3.1);                            // [T = char, U = double]
-    }
+    });
 
-    {
+    r.add("Default Template Parameters", "default_template_parameters", [] {
         using namespace default_template_parameters;
 
-        std::cout << "\n=== Default Template Parameters\n" << std::endl;
-
         add<int>(); // [T = int]
         add<>();    // [T = char *]
         add();      // [T = char *]
-    }
+    });
 
-    {
+    r.add("Template Type Deduction #1 (Value and Pointer)", "template_type_deduction_real_deal_1", [] {
         using namespace template_type_deduction_real_deal_1;
 
-        std::cout << "\n=== Template Type Deduction #1 (Value and Pointer)\n" << std::endl;
-
         int i{};
         f(i);  // [T = int]
         f(&i); // [T = int]
-    }
+    });
 
-    {
+    r.add("Template Type Deduction #2 (Reference)", "template_type_deduction_real_deal_2", [] {
         using namespace template_type_deduction_real_deal_2;
 
-        std::cout << "\n=== Template Type Deduction #2 (Reference)\n" << std::endl;
-
         int i{};
         f(i); // [T = int]
-    }
+    });
 
-    {
+    r.add("Template Type Deduction #3 (Forwarding/Universal Reference)", "template_type_deduction_real_deal_3", [] {
         using namespace template_type_deduction_real_deal_3;
 
-        std::cout << "\n=== Template Type Deduction #3 (Forwarding/Universal Reference)\n" << std::endl;
-
         // Combining two reference types mins the number of ampersands (reference collapsing):
         // &  +  & =  &
         // &  + && =  &
@@ -951,33 +931,27 @@ main()
         // we pass l-value reference
         f(i); // [T = int&]
         // i = int& -> T = int&, bc T&& = int& + && = int& = type of i/type of param
-    }
+    });
 
-    {
+    r.add("Case in which && is deduced", "case_in_which_refref_is_deduced", [] {
         using namespace case_in_which_refref_is_deduced;
 
-        std::cout << "\n=== Case in which && is deduced\n" << std::endl;
-
         f(g); // [T=int&&]
-    }
+    });
 
-    {
+    r.add("Forwarding/Universal Reference and CV-Collapsing", "reference_and_cv_collapsing", [] {
         using namespace reference_and_cv_collapsing;
 
-        std::cout << "\n=== Forwarding/Universal Reference and CV-Collapsing\n" << std::endl;
-
         const int i = 42;
         f(i);            // [T=const int&]
         f(std::move(i)); // [T=const int]
-    }
+    });
 
-    {
+    r.add("Deducing T&, not T&&", "deducing_Tref_not_Trefref", [] {
         using namespace deducing_Tref_not_Trefref;
 
         // Forwarding references (T&&) are too easy. Everything works with them.
 
-        std::cout << "\n=== Deducing T&, not T&&\n" << std::endl;
-
         int i = 42;
 
         // pass l-value ref
@@ -997,13 +971,11 @@ main()
 
         // pass volatile r-value ref
         // f(static_cast<volatile int &&>(i)); // ERROR
-    }
+    });
 
-    {
+    r.add("r-Values are kinda like const lvalues", "rvalues_are_kinda_like_const_lvalues", [] {
         using namespace rvalues_are_kinda_like_const_lvalues;
 
-        std::cout << "\n=== r-Values are kinda like const lvalues\n" << std::endl;
-
         int i = 42;
 
         // pass l-value ref
@@ -1017,76 +989,142 @@ main()
 
         // pass r-value ref
         // f(static_cast<int &&>(i));    // error
-    }
+    });
 
-    {
+    r.add("Defining a Template Specialization #1", "defining_a_template_specialization_1", [] {
         using namespace defining_a_template_specialization_1;
 
-        std::cout << "\n=== Defining a Template Specialization #1\n" << std::endl;
-
         std::cout << is_void<int>::value << std::endl;  // false
         std::cout << is_void<void>::value << std::endl; // true
-    }
+    });
 
-    {
-        using namespace partial_specialization_1;
+    r.add("Defining a Template Specialization #2", "defining_a_template_specialization_2", [] {
+        using namespace defining_a_template_specialization_2;
 
-        std::cout << "\n=== Partial Specialization #1\n" << std::endl;
+        // NOTE: `abs<int>`, not `abs`: a plain call would prefer the non-template ::abs(int) from <stdlib.h>.
+        std::cout << abs<int>(-42) << std::endl; // 42
+        try
+        {
+            abs<int>(INT_MIN);
+        }
+        catch (const std::domain_error &e)
+        {
+            std::cout << e.what() << std::endl; // oops
+        }
+    });
+
+    r.add("Specializing a library's template: formatting::formatter", "specializing_a_library_template", [] {
+        using namespace specializing_a_library_template;
+
+        // checked at compile time, written in one go when `out` goes out of scope
+        formatting::sink out;
+        println(out, "{} = {:.3f}", fraction{1, 3}, 1.0 / 3); // 1/3 = 0.333
+        println(out, "{{{:x}}} {} {}", 255, true, 0.1);         // {ff} true 0.1
+        // println(out, "{:x}", 0.5);                          // error: {:x} needs an integer argument
+        // println(out, "{} {}", 1);                           // error: more placeholders than arguments
+    });
+
+    r.add("Overflow Policies as Template Parameters", "overflow_policies", [] {
+        using namespace overflow_policies;
+
+        std::cout << abs<saturate>(INT_MIN) << std::endl;                // 2147483647
+        std::cout << abs<wrap>(INT_MIN) << std::endl;                    // -2147483648
+        std::cout << int(abs<saturate>(std::int8_t(-128))) << std::endl; // 127
+        std::cout << abs<expected>(INT_MIN).has_value() << std::endl;    // false
+
+        // batch: branch-free, one aggregated overflow flag at the end
+        std::vector<int>           in = {-1, INT_MIN, 3, -4};
+        std::vector<int>           out(in.size());
+        std::vector<std::uint64_t> bits(1);
+        std::cout << abs(in, std::span(out), collect{bits}) << std::endl; // true
+        std::cout << bits[0] << std::endl;                                // 2
+    });
+
+    r.add("Partial Specialization #1", "partial_specialization_1", [] {
+        using namespace partial_specialization_1;
 
         std::cout << is_array<int> << std::endl;   // false
         std::cout << is_array<int[]> << std::endl; // true
-    }
+    });
 
-    {
+    r.add("Partial Specialization #2", "partial_specialization_2", [] {
         using namespace partial_specialization_2;
 
-        std::cout << "\n=== Partial Specialization #2\n" << std::endl;
-
         std::cout << is_array<int> << std::endl;    // false
         std::cout << is_array<int[]> << std::endl;  // true
         std::cout << is_array<int[8]> << std::endl; // true
-    }
+    });
 
-    {
+    r.add("Which Specialization is being called ?", "which_specialization_is_called", [] {
         using namespace which_specialization_is_called;
 
-        std::cout << "\n=== Which Specialization is being called ?\n" << std::endl;
-
         A<int>     a1 [[maybe_unused]]; // uses primary
         A<int *>   a2 [[maybe_unused]]; // uses 1st partial specialization
         A<int ***> a3 [[maybe_unused]]; // uses 2nd partial specialization
         A<void>    a4 [[maybe_unused]]; // uses full specialization
-    }
-
-    {
-        using namespace function_templates_cannot_be_partially_specialized_1;
-
-        std::cout << "\n=== Function Templates can't be partially specialized - only fully! 1/2\n" << std::endl;
-
-        int i{};
-        std::cout << is_pointer(i) << std::endl;  // false
-        std::cout << is_pointer(&i) << std::endl; // true
-    }
-
-    {
-        using namespace function_templates_cannot_be_partially_specialized_2;
-
-        std::cout << "\n=== Function Templates can't be partially specialized - only fully! 2/2\n" << std::endl;
 
-        int i{};
-        std::cout << is_pointer(i) << std::endl;  // false
-        std::cout << is_pointer(&i) << std::endl; // true
-    }
-
-    {
-        using namespace how_to_partially_specialize_a_function;
-
-        std::cout << "\n=== Function Templates can't be partially specialized - only fully!\n" << std::endl;
-
-        int i{};
-        std::cout << is_pointer(i) << std::endl;  // false
-        std::cout << is_pointer(&i) << std::endl; // true
-    }
+        // Peeling one `*` (or one list element) per specialization costs one instantiation per step. typelist.hpp
+        // does the same kind of work in one pack expansion.
+        using namespace type_lists;
+
+        using L = list<int, char, double, char, short>;
+        static_assert(std::is_same_v<at_t<L, 2>, double>);
+        static_assert(find_v<L, short> == 4);
+        static_assert(std::is_same_v<unique_t<L>, list<int, char, double, short>>);
+        static_assert(std::is_same_v<sort_by_size_t<L>, list<char, char, short, int, double>>);
+        static_assert(std::is_same_v<filter_t<L, std::is_integral>, list<int, char, char, short>>);
+    });
+
+    r.add("Function Templates can't be partially specialized - only fully! 1/2",
+          "function_templates_cannot_be_partially_specialized_1", [] {
+              using namespace function_templates_cannot_be_partially_specialized_1;
+
+              int i{};
+              std::cout << is_pointer(i) << std::endl;  // false
+              std::cout << is_pointer(&i) << std::endl; // true
+          });
+
+    r.add("Function Templates can't be partially specialized - only fully! 2/2",
+          "function_templates_cannot_be_partially_specialized_2", [] {
+              using namespace function_templates_cannot_be_partially_specialized_2;
+
+              int i{};
+              std::cout << is_pointer(i) << std::endl;  // false
+              std::cout << is_pointer(&i) << std::endl; // true
+          });
+
+    r.add("Function Templates can't be partially specialized - only fully!",
+          "how_to_partially_specialize_a_function", [] {
+              using namespace how_to_partially_specialize_a_function;
+
+              int i{};
+              std::cout << is_pointer(i) << std::endl;  // false
+              std::cout << is_pointer(&i) << std::endl; // true
+          });
+
+    r.add("Partial specialization as a gate: only pointer-free types go to disk", "persistent", [] {
+        static_assert(persistent::is_persistable<double>);
+        static_assert(persistent::is_persistable<std::array<int, 3>>);
+        static_assert(!persistent::is_persistable<int *>);
+        static_assert(!persistent::is_persistable<const char *[2]>);
+
+        std::string path = (std::filesystem::temp_directory_path() / "f_persistent.myvec").string();
+        alias_templates::myvec<double> v{1.5, 2.5, 4};
+        persistent::save(path, v);
+        {
+            persistent::mapped<double> m(path); // no copy: a span over the mapped file
+            std::cout << m.size() << ' ' << m[2] << std::endl; // 3 4
+            try
+            {
+                persistent::mapped<float> wrong(path);
+            }
+            catch (const persistent::format_error &)
+            {
+                std::cout << "float != double" << std::endl;
+            }
+        }
+        std::filesystem::remove(path);
+    });
 
     // End of Part 1
 
@@ -1099,4 +1137,55 @@ main()
     // -----------------+----------------+-------------------------------+-----------------------------------
 
     // * In C++17 we have CTAD = Class Template Argument Deduction
+
+    // Begin Part 2
+
+    r.add("Good Tag Dispatch", "good_tag_dispatch", [] {
+        using namespace good_tag_dispatch;
+
+        tree<int> t = {50, 30, 80, 10, 40};
+        t.insert(20);
+        std::cout << t.contains(40) << std::endl; // true
+
+        // tree_iterator has no `+`, but supports_logarithmic_jump -> advance_impl uses jump()
+        std::cout << *advance(t.begin(), 2) << std::endl; // 30
+
+        // mylist_iterator has neither -> advance_impl steps with ++
+        class_templates::mylist<int> l = {1, 2, 3, 4};
+        std::cout << *advance(l.begin(), 2) << std::endl; // 3
+
+        // order statistics
+        std::cout << t.rank(40) << std::endl;   // 3
+        std::cout << *t.select(4) << std::endl; // 50
+
+        // supports_segments: one tight loop per node instead of one ++ per element
+        int sum = 0;
+        good_tag_dispatch::for_each(t.begin(), t.end(), [&](int x) { sum += x; });
+        std::cout << sum << std::endl;                                                         // 230
+        std::cout << (good_tag_dispatch::find(l.begin(), l.end(), 3) != l.end()) << std::endl; // true
+
+        // the parallel algorithms dispatch the same way: random access splits, mylist is walked in chunks
+        parallel::thread_pool pool(2);
+        std::vector<int>      ones(1000, 1), counts(1000);
+        parallel::inclusive_scan(pool, ones.begin(), ones.end(), counts.begin());
+        std::cout << counts.back() << std::endl; // 1000
+        auto square = [](int x) { return x * x; };
+        int  total  = parallel::transform_reduce(pool, l.begin(), l.end(), 0, std::plus<>{}, square, /*grain=*/1);
+        std::cout << total << std::endl; // 30
+
+        // lazy streams: coroutines that only run as far as the consumer asks
+        auto big  = coroutines::filter(coroutines::in_order(t), [](int x) { return x > 25; });
+        auto tens = coroutines::transform(std::move(big), [](int x) { return x / 10; });
+        for (int x : tens)
+        {
+            std::cout << x << ' '; // 3 4 5 8
+        }
+        std::cout << std::endl;
+        for (auto node : t.level_order())
+        {
+            std::cout << node.depth << ':' << node.keys.size() << std::endl; // 0:6 (the root is a leaf)
+        }
+    });
+
+    return sections::run(r, argc, argv);
 }
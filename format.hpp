@@ -0,0 +1,503 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+namespace formatting
+{
+    // std::format-style output whose format strings are checked by the compiler:
+    //
+    //   formatting::sink out;                                   // buffers for stdout
+    //   println(out, "{} items, {:.2f} ms ({:x})", n, ms, bits);
+    //   std::string s = formatting::format("{}/{}", a, b);
+    //
+    // The format string is parsed in a consteval constructor: a placeholder without an argument (or the other way
+    // round), a stray brace or a spec that doesn't fit its argument's type doesn't compile. At run time only the
+    // literal text between the placeholders (found at compile time) is copied and each argument converted.
+    //
+    //   {}       any formattable argument: integers and floats through std::to_chars (floats in the shortest form
+    //            that reads back exactly), bool as true/false, char as a character, strings as they are
+    //   {:x}     integers in hexadecimal
+    //   {:.Nf}   floats in fixed notation with N (0-99) decimals
+    //   {{ }}    literal braces
+    //
+    // Other types are formatted by specializing formatter<T> (see the one for bool below); those take `{}` only.
+    //
+    // Output goes into a buffer, growing as needed. A sink is a buffer over a FILE: print() appends, and once the
+    // buffer holds flush_at bytes (64 KiB by default) it goes to the FILE in one fwrite, which stdio passes
+    // straight to write(2). Nothing is written per line, and std::endl has no counterpart. A sink is flushed on
+    // destruction; it is not thread safe.
+
+    // a growable char buffer
+    class buffer
+    {
+      public:
+        buffer() = default;
+
+        buffer(const buffer &) = delete;
+        buffer &
+        operator=(const buffer &) = delete;
+
+        // room for n more chars at the end, to be committed
+        char *
+        prepare(std::size_t n)
+        {
+            if (capacity_ - size_ < n) [[unlikely]]
+            {
+                grow(size_ + n);
+            }
+            return data_.get() + size_;
+        }
+
+        void
+        commit(std::size_t n) noexcept
+        {
+            size_ += n;
+        }
+
+        void
+        append(std::string_view s)
+        {
+            if (s.empty())
+            {
+                return;
+            }
+            std::memcpy(prepare(s.size()), s.data(), s.size());
+            size_ += s.size();
+        }
+
+        void
+        push_back(char c)
+        {
+            *prepare(1) = c;
+            size_++;
+        }
+
+        std::string_view
+        view() const noexcept
+        {
+            return {data_.get(), size_};
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return size_;
+        }
+
+        void
+        clear() noexcept
+        {
+            size_ = 0;
+        }
+
+      private:
+        void
+        grow(std::size_t needed)
+        {
+            std::size_t capacity = capacity_ ? capacity_ : 256;
+            while (capacity < needed)
+            {
+                capacity *= 2;
+            }
+            auto data = std::make_unique_for_overwrite<char[]>(capacity);
+            if (size_)
+            {
+                std::memcpy(data.get(), data_.get(), size_);
+            }
+            data_     = std::move(data);
+            capacity_ = capacity;
+        }
+
+        std::unique_ptr<char[]> data_;
+        std::size_t             size_     = 0;
+        std::size_t             capacity_ = 0;
+    };
+
+    class sink
+    {
+      public:
+        explicit sink(std::FILE *file = stdout, std::size_t flush_at = 1 << 16) : file_(file), flush_at_(flush_at)
+        {
+        }
+
+        sink(const sink &) = delete;
+        sink &
+        operator=(const sink &) = delete;
+
+        ~sink()
+        {
+            flush();
+        }
+
+        buffer &
+        buf() noexcept
+        {
+            return buf_;
+        }
+
+        // after every print: writes only once the buffer is full enough
+        void
+        maybe_flush()
+        {
+            if (buf_.size() >= flush_at_)
+            {
+                flush();
+            }
+        }
+
+        void
+        flush()
+        {
+            if (buf_.size() && std::fwrite(buf_.view().data(), 1, buf_.size(), file_) != buf_.size())
+            {
+                failed_ = true;
+            }
+            buf_.clear();
+        }
+
+        // false once a write has failed
+        explicit
+        operator bool() const noexcept
+        {
+            return !failed_;
+        }
+
+      private:
+        buffer      buf_;
+        std::FILE  *file_;
+        std::size_t flush_at_;
+        bool        failed_ = false;
+    };
+
+    // a placeholder's conversion
+    struct spec
+    {
+        char type      = 0; // 0, 'x' or 'f'
+        int  precision = 0; // of 'f'
+    };
+
+    // formatter<T>::write(buffer &, const T &, spec) appends one argument
+    template <typename T>
+    struct formatter;
+
+    template <typename T>
+    concept formattable = requires(buffer &out, const T &x, spec s) { formatter<T>::write(out, x, s); };
+
+    template <typename T>
+        requires std::integral<T> && (!std::is_same_v<T, bool>) && (!std::is_same_v<T, char>)
+    struct formatter<T>
+    {
+        static void
+        write(buffer &out, T x, spec s)
+        {
+            constexpr std::size_t room = sizeof(T) * 8 / 3 + 3; // enough for any base >= 8, sign included
+            char                 *p    = out.prepare(room);
+            out.commit(static_cast<std::size_t>(std::to_chars(p, p + room, x, s.type ? 16 : 10).ptr - p));
+        }
+    };
+
+    template <std::floating_point T>
+    struct formatter<T>
+    {
+        static void
+        write(buffer &out, T x, spec s)
+        {
+            // The shortest form fits in 64 chars. Fixed notation has up to max_exponent10 + 1 digits before the
+            // point (4933 for long double), then the point and the decimals, and maybe a sign. The room only grows
+            // if that estimate is somehow short: an argument is never dropped.
+            std::size_t room = s.type ? std::size_t(std::numeric_limits<T>::max_exponent10) + s.precision + 4 : 64;
+            while (true)
+            {
+                char                *p = out.prepare(room);
+                std::to_chars_result r = s.type ? std::to_chars(p, p + room, x, std::chars_format::fixed, s.precision)
+                                                : std::to_chars(p, p + room, x);
+                if (r.ec == std::errc())
+                {
+                    out.commit(static_cast<std::size_t>(r.ptr - p));
+                    return;
+                }
+                room *= 2;
+            }
+        }
+    };
+
+    template <>
+    struct formatter<bool>
+    {
+        static void
+        write(buffer &out, bool x, spec)
+        {
+            out.append(x ? "true" : "false");
+        }
+    };
+
+    template <>
+    struct formatter<char>
+    {
+        static void
+        write(buffer &out, char c, spec)
+        {
+            out.push_back(c);
+        }
+    };
+
+    template <>
+    struct formatter<std::string_view>
+    {
+        static void
+        write(buffer &out, std::string_view s, spec)
+        {
+            out.append(s);
+        }
+    };
+
+    template <>
+    struct formatter<std::string> : formatter<std::string_view>
+    {
+    };
+
+    template <>
+    struct formatter<const char *> : formatter<std::string_view>
+    {
+    };
+
+    template <>
+    struct formatter<char *> : formatter<std::string_view>
+    {
+    };
+
+    template <std::size_t N>
+    struct formatter<char[N]> : formatter<std::string_view>
+    {
+    };
+
+    namespace detail
+    {
+        // Not constexpr: calling it while parsing a format string stops the compilation there, with the reason.
+        inline void
+        invalid_format_string(const char *)
+        {
+        }
+
+        enum class kind
+        {
+            integer,
+            floating,
+            other
+        };
+
+        template <typename T>
+        constexpr kind
+        kind_of()
+        {
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>)
+            {
+                return kind::integer;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                return kind::floating;
+            }
+            else
+            {
+                return kind::other;
+            }
+        }
+
+        struct field
+        {
+            std::size_t begin = 0; // of the '{'
+            std::size_t end   = 0; // past the '}'
+            spec        s;
+        };
+
+        // s with {{ and }} collapsed, if the format string has any
+        inline void
+        literal(buffer &out, std::string_view s, bool escapes)
+        {
+            if (!escapes)
+            {
+                out.append(s);
+                return;
+            }
+            for (std::size_t i = 0; i < s.size(); i++)
+            {
+                out.push_back(s[i]);
+                if ((s[i] == '{' || s[i] == '}') && i + 1 < s.size() && s[i + 1] == s[i])
+                {
+                    i++;
+                }
+            }
+        }
+
+    } // namespace detail
+
+    template <typename... Args>
+    class basic_format_string
+    {
+      public:
+        template <typename S>
+            requires std::convertible_to<const S &, std::string_view>
+        consteval basic_format_string(const S &s) : str_(s)
+        {
+            constexpr std::array<detail::kind, sizeof...(Args)> kinds = {detail::kind_of<Args>()...};
+
+            std::size_t arg = 0;
+            for (std::size_t i = 0; i < str_.size(); i++)
+            {
+                if (str_[i] == '}')
+                {
+                    if (i + 1 == str_.size() || str_[i + 1] != '}')
+                    {
+                        detail::invalid_format_string("unmatched '}' (write '}}' for a brace)");
+                    }
+                    escapes_ = true;
+                    i++;
+                    continue;
+                }
+                if (str_[i] != '{')
+                {
+                    continue;
+                }
+                if (i + 1 < str_.size() && str_[i + 1] == '{')
+                {
+                    escapes_ = true;
+                    i++;
+                    continue;
+                }
+                if (arg == sizeof...(Args))
+                {
+                    detail::invalid_format_string("more placeholders than arguments");
+                }
+
+                detail::field f;
+                f.begin = i++;
+                if (i < str_.size() && str_[i] == ':')
+                {
+                    i++;
+                    if (i < str_.size() && str_[i] == 'x')
+                    {
+                        f.s.type = 'x';
+                        i++;
+                    }
+                    else if (i < str_.size() && str_[i] == '.')
+                    {
+                        i++;
+                        std::size_t digits = 0;
+                        for (; i < str_.size() && str_[i] >= '0' && str_[i] <= '9' && digits < 2; i++, digits++)
+                        {
+                            f.s.precision = f.s.precision * 10 + (str_[i] - '0');
+                        }
+                        if (digits == 0 || i == str_.size() || str_[i] != 'f')
+                        {
+                            detail::invalid_format_string("expected {:.Nf} with N in 0-99");
+                        }
+                        f.s.type = 'f';
+                        i++;
+                    }
+                }
+                if (i == str_.size() || str_[i] != '}')
+                {
+                    detail::invalid_format_string("expected {}, {:x} or {:.Nf}");
+                }
+                f.end = i + 1;
+
+                if (f.s.type == 'x' && kinds[arg] != detail::kind::integer)
+                {
+                    detail::invalid_format_string("{:x} needs an integer argument");
+                }
+                if (f.s.type == 'f' && kinds[arg] != detail::kind::floating)
+                {
+                    detail::invalid_format_string("{:.Nf} needs a floating-point argument");
+                }
+                fields_[arg++] = f;
+            }
+            if (arg != sizeof...(Args))
+            {
+                detail::invalid_format_string("more arguments than placeholders");
+            }
+        }
+
+        std::string_view
+        str() const noexcept
+        {
+            return str_;
+        }
+
+        const std::array<detail::field, sizeof...(Args)> &
+        fields() const noexcept
+        {
+            return fields_;
+        }
+
+        bool
+        escapes() const noexcept
+        {
+            return escapes_;
+        }
+
+      private:
+        std::string_view                           str_;
+        std::array<detail::field, sizeof...(Args)> fields_{};
+        bool                                       escapes_ = false;
+    };
+
+    // type_identity: the arguments alone decide Args
+    template <typename... Args>
+    using format_string = basic_format_string<std::remove_cvref_t<std::type_identity_t<Args>>...>;
+
+    template <formattable... Args>
+    void
+    format_to(buffer &out, format_string<Args...> fmt, const Args &...args)
+    {
+        std::size_t           pos = 0;
+        std::size_t           i   = 0;
+        [[maybe_unused]] auto one = [&](const auto &arg) {
+            const detail::field &f = fmt.fields()[i++];
+            detail::literal(out, fmt.str().substr(pos, f.begin - pos), fmt.escapes());
+            formatter<std::remove_cvref_t<decltype(arg)>>::write(out, arg, f.s);
+            pos = f.end;
+        };
+        (one(args), ...);
+        detail::literal(out, fmt.str().substr(pos), fmt.escapes());
+    }
+
+    template <formattable... Args>
+    std::string
+    format(format_string<Args...> fmt, const Args &...args)
+    {
+        buffer out;
+        format_to(out, fmt, args...);
+        return std::string(out.view());
+    }
+
+    template <formattable... Args>
+    void
+    print(sink &out, format_string<Args...> fmt, const Args &...args)
+    {
+        format_to(out.buf(), fmt, args...);
+        out.maybe_flush();
+    }
+
+    template <formattable... Args>
+    void
+    println(sink &out, format_string<Args...> fmt, const Args &...args)
+    {
+        format_to(out.buf(), fmt, args...);
+        out.buf().push_back('\n');
+        out.maybe_flush();
+    }
+
+} // namespace formatting
@@ -0,0 +1,338 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "allocators.hpp" // allocators::pool: the size-class freelists the frames are recycled through
+#include "segmented.hpp"  // good_tag_dispatch::segments_tag
+
+namespace coroutines
+{
+    // generator<T>: a lazy sequence produced by a coroutine (what std::generator is in C++23).
+    //
+    //   generator<const int &> evens(const tree<int> &t)
+    //   {
+    //       for (const int &x : t)
+    //       {
+    //           if (x % 2 == 0)
+    //           {
+    //               co_yield x;   // suspends here until the consumer asks for the next element
+    //           }
+    //       }
+    //   }
+    //
+    //   for (const int &x : evens(t)) ...   // an input range: begin() runs up to the first co_yield
+    //
+    // T may be a reference (the consumer sees the producer's object) or a value (the consumer sees the yielded
+    // temporary, alive until the next resumption). An exception escaping the coroutine comes out of begin()/++.
+    //
+    // Every call allocates a coroutine frame. The Frames policy decides where from:
+    //
+    //   frames::pooled   (default) a per-thread allocators::pool: after the first few generators, a frame is a
+    //                    freelist pop and push. A generator must be destroyed on the thread that created it.
+    //   frames::heap     operator new
+    //
+    // Over tree and mylist (anything with segmented iterators, see segmented.hpp):
+    //
+    //   in_order(c)        the elements in iteration order, one segment (leaf/node) at a time
+    //   filter(g, pred)    the elements of g satisfying pred
+    //   transform(g, f)    f(x) for every element x of g
+    //
+    // and tree::level_order(), breadth-first over the tree's nodes.
+
+    namespace frames
+    {
+        struct heap
+        {
+            static void *
+            allocate(std::size_t bytes)
+            {
+                return ::operator new(bytes);
+            }
+
+            static void
+            deallocate(void *p, std::size_t bytes) noexcept
+            {
+                ::operator delete(p, bytes);
+            }
+        };
+
+        struct pooled
+        {
+            static allocators::pool &
+            frame_pool()
+            {
+                static thread_local allocators::pool pool;
+                return pool;
+            }
+
+            static void *
+            allocate(std::size_t bytes)
+            {
+                return frame_pool().allocate(bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            }
+
+            static void
+            deallocate(void *p, std::size_t bytes) noexcept
+            {
+                frame_pool().deallocate(p, bytes, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+            }
+        };
+
+    } // namespace frames
+
+    template <typename T, typename Frames = frames::pooled>
+    class generator
+    {
+      public:
+        using value_type = std::remove_cvref_t<T>;
+        using reference  = std::conditional_t<std::is_reference_v<T>, T, const value_type &>;
+        using pointer    = std::add_pointer_t<reference>;
+
+        struct promise_type
+        {
+            pointer            current = nullptr;
+            std::exception_ptr error;
+
+            static void *
+            operator new(std::size_t bytes)
+            {
+                return Frames::allocate(bytes);
+            }
+
+            static void
+            operator delete(void *p, std::size_t bytes) noexcept
+            {
+                Frames::deallocate(p, bytes);
+            }
+
+            generator
+            get_return_object() noexcept
+            {
+                return generator(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_always
+            initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always
+            final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            // For a value T this also binds temporaries, which live until the coroutine is resumed, i.e. as long as
+            // the consumer can see them.
+            std::suspend_always
+            yield_value(std::remove_reference_t<reference> &x) noexcept
+            {
+                current = std::addressof(x);
+                return {};
+            }
+
+            void
+            return_void() const noexcept
+            {
+            }
+
+            void
+            unhandled_exception() noexcept
+            {
+                error = std::current_exception();
+            }
+
+            // no co_await inside generators
+            void
+            await_transform() = delete;
+        };
+
+        struct sentinel
+        {
+        };
+
+        class iterator
+        {
+          public:
+            using iterator_concept = std::input_iterator_tag;
+            using value_type       = generator::value_type;
+            using difference_type  = std::ptrdiff_t;
+
+            iterator() = default;
+
+            reference
+            operator*() const
+            {
+                return static_cast<reference>(*handle_.promise().current);
+            }
+
+            pointer
+            operator->() const
+            {
+                return handle_.promise().current;
+            }
+
+            iterator &
+            operator++()
+            {
+                resume(handle_);
+                return *this;
+            }
+
+            void
+            operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool
+            operator==(const iterator &it, sentinel)
+            {
+                return it.handle_.done();
+            }
+
+          private:
+            friend class generator;
+
+            explicit iterator(std::coroutine_handle<promise_type> h) : handle_(h)
+            {
+            }
+
+            std::coroutine_handle<promise_type> handle_;
+        };
+
+        generator(generator &&other) noexcept : handle_(std::exchange(other.handle_, {}))
+        {
+        }
+
+        generator &
+        operator=(generator &&other) noexcept
+        {
+            if (this != &other)
+            {
+                if (handle_)
+                {
+                    handle_.destroy();
+                }
+                handle_ = std::exchange(other.handle_, {});
+            }
+            return *this;
+        }
+
+        ~generator()
+        {
+            if (handle_)
+            {
+                handle_.destroy();
+            }
+        }
+
+        // runs the coroutine up to its first co_yield; call once
+        iterator
+        begin()
+        {
+            resume(handle_);
+            return iterator(handle_);
+        }
+
+        sentinel
+        end() const noexcept
+        {
+            return {};
+        }
+
+      private:
+        explicit generator(std::coroutine_handle<promise_type> h) noexcept : handle_(h)
+        {
+        }
+
+        static void
+        resume(std::coroutine_handle<promise_type> h)
+        {
+            h.resume();
+            if (h.done() && h.promise().error)
+            {
+                std::rethrow_exception(std::exchange(h.promise().error, {}));
+            }
+        }
+
+        std::coroutine_handle<promise_type> handle_;
+    };
+
+    namespace detail
+    {
+        // one ++ per element
+        template <typename Frames, typename Iter>
+        generator<std::iter_reference_t<Iter>, Frames>
+        in_order_impl(Iter first, Iter last, std::false_type)
+        {
+            for (; first != last; ++first)
+            {
+                co_yield *first;
+            }
+        }
+
+        // one tight loop per segment, like good_tag_dispatch::for_each_impl
+        template <typename Frames, typename Iter>
+        generator<std::iter_reference_t<Iter>, Frames>
+        in_order_impl(Iter first, Iter last, std::true_type)
+        {
+            while (first != last)
+            {
+                for (auto &x : first.segment_until(last))
+                {
+                    co_yield x;
+                }
+                if (first.same_segment(last))
+                {
+                    break;
+                }
+                first = first.next_segment();
+            }
+        }
+
+    } // namespace detail
+
+    // NOTE: the container must outlive the generator (which holds only iterators into it).
+    template <typename Frames = frames::pooled, std::ranges::forward_range R>
+    generator<std::ranges::range_reference_t<const R>, Frames>
+    in_order(const R &r)
+    {
+        using Iter = std::ranges::iterator_t<const R>;
+        return detail::in_order_impl<Frames>(std::ranges::begin(r), std::ranges::end(r),
+                                             good_tag_dispatch::segments_tag<Iter>());
+    }
+
+    template <typename T, typename Frames, typename Pred>
+    generator<T, Frames>
+    filter(generator<T, Frames> g, Pred pred)
+    {
+        for (auto &&x : g)
+        {
+            if (pred(x))
+            {
+                co_yield static_cast<typename generator<T, Frames>::reference>(x);
+            }
+        }
+    }
+
+    template <typename T, typename Frames, typename F>
+    generator<std::invoke_result_t<F &, typename generator<T, Frames>::reference>, Frames>
+    transform(generator<T, Frames> g, F f)
+    {
+        for (auto &&x : g)
+        {
+            co_yield f(static_cast<typename generator<T, Frames>::reference>(x));
+        }
+    }
+
+} // namespace coroutines
@@ -0,0 +1,100 @@
+// Explicit instantiation definitions for the declarations in instantiations.hpp. Built as the `templates`
+// library, so these specializations are compiled once instead of in every translation unit that uses them.
+
+#include "instantiations.hpp"
+
+namespace function_templates
+{
+    template int
+    myabs(int);
+    template long
+    myabs(long);
+    template float
+    myabs(float);
+    template double
+    myabs(double);
+
+    template void
+    myabs<int>(std::type_identity_t<std::span<const int>>, std::span<int>);
+    template void
+    myabs<long>(std::type_identity_t<std::span<const long>>, std::span<long>);
+    template void
+    myabs<float>(std::type_identity_t<std::span<const float>>, std::span<float>);
+    template void
+    myabs<double>(std::type_identity_t<std::span<const double>>, std::span<double>);
+
+    template void
+    myabs(std::span<int>);
+    template void
+    myabs(std::span<long>);
+    template void
+    myabs(std::span<float>);
+    template void
+    myabs(std::span<double>);
+
+    namespace detail
+    {
+        template void
+        myabs_kernel(isa, const int *, int *, std::size_t);
+        template void
+        myabs_kernel(isa, const long *, long *, std::size_t);
+        template void
+        myabs_kernel(isa, const float *, float *, std::size_t);
+        template void
+        myabs_kernel(isa, const double *, double *, std::size_t);
+
+    } // namespace detail
+
+} // namespace function_templates
+
+namespace overflow_policies
+{
+    template bool
+    abs<wrap, int>(std::type_identity_t<std::span<const int>>, std::span<int>, wrap);
+    template bool
+    abs<wrap, long>(std::type_identity_t<std::span<const long>>, std::span<long>, wrap);
+    template bool
+    abs<saturate, int>(std::type_identity_t<std::span<const int>>, std::span<int>, saturate);
+    template bool
+    abs<saturate, long>(std::type_identity_t<std::span<const long>>, std::span<long>, saturate);
+    template bool
+    abs<throw_on_overflow, int>(std::type_identity_t<std::span<const int>>, std::span<int>, throw_on_overflow);
+    template bool
+    abs<throw_on_overflow, long>(std::type_identity_t<std::span<const long>>, std::span<long>, throw_on_overflow);
+    template bool
+    abs<collect, int>(std::type_identity_t<std::span<const int>>, std::span<int>, collect);
+    template bool
+    abs<collect, long>(std::type_identity_t<std::span<const long>>, std::span<long>, collect);
+
+} // namespace overflow_policies
+
+namespace good_tag_dispatch
+{
+
+    template tree_iterator<int>
+    advance(tree_iterator<int>, int);
+    template tree_iterator<long>
+    advance(tree_iterator<long>, int);
+    template tree_iterator<float>
+    advance(tree_iterator<float>, int);
+    template tree_iterator<double>
+    advance(tree_iterator<double>, int);
+
+    template class_templates::mylist<int>::iterator
+    advance(class_templates::mylist<int>::iterator, int);
+    template class_templates::mylist<int>::const_iterator
+    advance(class_templates::mylist<int>::const_iterator, int);
+    template class_templates::mylist<long>::iterator
+    advance(class_templates::mylist<long>::iterator, int);
+    template class_templates::mylist<long>::const_iterator
+    advance(class_templates::mylist<long>::const_iterator, int);
+    template class_templates::mylist<float>::iterator
+    advance(class_templates::mylist<float>::iterator, int);
+    template class_templates::mylist<float>::const_iterator
+    advance(class_templates::mylist<float>::const_iterator, int);
+    template class_templates::mylist<double>::iterator
+    advance(class_templates::mylist<double>::iterator, int);
+    template class_templates::mylist<double>::const_iterator
+    advance(class_templates::mylist<double>::const_iterator, int);
+
+} // namespace good_tag_dispatch
@@ -0,0 +1,121 @@
+#pragma once
+
+// Explicit instantiation declarations for the common specializations of the reusable templates.
+//
+// The definitions are in instantiations.cpp (the `templates` library in meson.build). A translation unit that
+// includes this header does not instantiate these specializations itself. It only calls them, and the library
+// provides them once for the whole program:
+//
+//   extern template         // "instantiation already happened in another translation unit"
+//   int myabs(int);
+//
+// NOTE: This has no effect on constexpr and inline functions, e.g. the scalar overflow_policies::abs<Policy>(T).
+// mylist and tree are deliberately not instantiated here. Their members are defined in the class, so they are inline
+// and every user still instantiates them for inlining. An explicit instantiation would also link in every member
+// for every element type. bench/extern_templates measures both effects.
+
+#include <span>
+#include <type_traits>
+
+#include "abs_policy.hpp"
+#include "advance.hpp"
+#include "myabs.hpp"
+#include "mylist.hpp"
+#include "tree.hpp"
+
+namespace function_templates
+{
+    extern template int
+    myabs(int);
+    extern template long
+    myabs(long);
+    extern template float
+    myabs(float);
+    extern template double
+    myabs(double);
+
+    extern template void
+    myabs<int>(std::type_identity_t<std::span<const int>>, std::span<int>);
+    extern template void
+    myabs<long>(std::type_identity_t<std::span<const long>>, std::span<long>);
+    extern template void
+    myabs<float>(std::type_identity_t<std::span<const float>>, std::span<float>);
+    extern template void
+    myabs<double>(std::type_identity_t<std::span<const double>>, std::span<double>);
+
+    extern template void
+    myabs(std::span<int>);
+    extern template void
+    myabs(std::span<long>);
+    extern template void
+    myabs(std::span<float>);
+    extern template void
+    myabs(std::span<double>);
+
+    namespace detail
+    {
+        extern template void
+        myabs_kernel(isa, const int *, int *, std::size_t);
+        extern template void
+        myabs_kernel(isa, const long *, long *, std::size_t);
+        extern template void
+        myabs_kernel(isa, const float *, float *, std::size_t);
+        extern template void
+        myabs_kernel(isa, const double *, double *, std::size_t);
+
+    } // namespace detail
+
+} // namespace function_templates
+
+namespace overflow_policies
+{
+    // batch form only: the scalar abs is constexpr (see above)
+    extern template bool
+    abs<wrap, int>(std::type_identity_t<std::span<const int>>, std::span<int>, wrap);
+    extern template bool
+    abs<wrap, long>(std::type_identity_t<std::span<const long>>, std::span<long>, wrap);
+    extern template bool
+    abs<saturate, int>(std::type_identity_t<std::span<const int>>, std::span<int>, saturate);
+    extern template bool
+    abs<saturate, long>(std::type_identity_t<std::span<const long>>, std::span<long>, saturate);
+    extern template bool
+    abs<throw_on_overflow, int>(std::type_identity_t<std::span<const int>>, std::span<int>, throw_on_overflow);
+    extern template bool
+    abs<throw_on_overflow, long>(std::type_identity_t<std::span<const long>>, std::span<long>, throw_on_overflow);
+    extern template bool
+    abs<collect, int>(std::type_identity_t<std::span<const int>>, std::span<int>, collect);
+    extern template bool
+    abs<collect, long>(std::type_identity_t<std::span<const long>>, std::span<long>, collect);
+
+} // namespace overflow_policies
+
+namespace good_tag_dispatch
+{
+
+    extern template tree_iterator<int>
+    advance(tree_iterator<int>, int);
+    extern template tree_iterator<long>
+    advance(tree_iterator<long>, int);
+    extern template tree_iterator<float>
+    advance(tree_iterator<float>, int);
+    extern template tree_iterator<double>
+    advance(tree_iterator<double>, int);
+
+    extern template class_templates::mylist<int>::iterator
+    advance(class_templates::mylist<int>::iterator, int);
+    extern template class_templates::mylist<int>::const_iterator
+    advance(class_templates::mylist<int>::const_iterator, int);
+    extern template class_templates::mylist<long>::iterator
+    advance(class_templates::mylist<long>::iterator, int);
+    extern template class_templates::mylist<long>::const_iterator
+    advance(class_templates::mylist<long>::const_iterator, int);
+    extern template class_templates::mylist<float>::iterator
+    advance(class_templates::mylist<float>::iterator, int);
+    extern template class_templates::mylist<float>::const_iterator
+    advance(class_templates::mylist<float>::const_iterator, int);
+    extern template class_templates::mylist<double>::iterator
+    advance(class_templates::mylist<double>::iterator, int);
+    extern template class_templates::mylist<double>::const_iterator
+    advance(class_templates::mylist<double>::const_iterator, int);
+
+} // namespace good_tag_dispatch
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdio>
+
+namespace function_templates_cannot_be_partially_specialized_1
+{
+    // Function templates cannot be partially specialized!
+    // Only full/explicit specialization allowed !
+
+    template <typename T>
+    bool
+    is_pointer(T)
+    {
+        return false;
+    }
+
+    // this is NOT a partial specialization
+    template <typename T>
+    bool
+    is_pointer(T *)
+    {
+        return true;
+    }
+
+    // Now we have two primary function templates in the same overload set. Dangerous!
+
+} // namespace function_templates_cannot_be_partially_specialized_1
+
+namespace function_templates_cannot_be_partially_specialized_2
+{
+    // Depending where you put the full specialization (after first or second primary function template) you get
+    // possibly different behavior. Dangerous! If you put the full specialization after first primary function template
+    // it will be a specialization for the first primary template. If you put the full specialization after second
+    // primary function template it will be a specialization for the second primary template.
+
+    // 1st primary function template
+    template <typename T>
+    bool
+    is_pointer(T)
+    {
+        return false;
+    }
+
+    // full specialization
+    // NOTE: `inline`, because a full specialization is an ordinary function as far as the ODR is concerned, and
+    // this header is included from more than one translation unit.
+    template <>
+    inline bool
+    is_pointer(void *)
+    {
+        puts(__PRETTY_FUNCTION__);
+        return true;
+    }
+
+    // 2nd primary function template
+    template <typename T>
+    bool
+    is_pointer(T *)
+    {
+        return true;
+    }
+
+} // namespace function_templates_cannot_be_partially_specialized_2
+
+namespace how_to_partially_specialize_a_function
+{
+    // How to partially specialize a function
+
+    // primary template
+    template <typename T>
+    struct is_pointer_impl
+    {
+        static bool
+        _()
+        {
+            return false;
+        }
+    };
+
+    // partial specialization (classes can be partially specialized!)
+    template <typename T>
+    struct is_pointer_impl<T *>
+    {
+        static bool
+        _()
+        {
+            return true;
+        }
+    };
+
+    template <typename T>
+    bool
+    is_pointer(T)
+    {
+        return is_pointer_impl<T>::_();
+    }
+
+} // namespace how_to_partially_specialize_a_function
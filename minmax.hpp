@@ -0,0 +1,370 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "myabs.hpp" // function_templates::detail::best_isa(): the same CPU dispatch as the batch myabs
+
+namespace extrema
+{
+    // max/min/clamp/minmax for arguments of different types (see how_many_people_have_seen_this: std::max(f(), 42)
+    // doesn't compile for a short f()). They return by value, in a type that holds the result:
+    //
+    //   max(a, b)    std::common_type_t<A, B>
+    //   min(a, b)    the same, except that it is made signed when it is unsigned but one argument is signed:
+    //                min(-1, 1u) is int(-1), where std::min<unsigned>(-1, 1u) would be 1
+    //
+    // Integers are compared by value whatever their signedness (like std::cmp_less): max(-1, 1u) is 1u, not -1
+    // converted to UINT_MAX.
+    //
+    // Range versions over contiguous ranges of integers, float or double, vectorized (SSE2/AVX2/AVX-512 picked at
+    // run time, like the batch myabs):
+    //
+    //   minmax(r)                  {smallest, largest} in one pass; std::invalid_argument if r is empty
+    //   argmin(r), argmax(r)       index of the first smallest/largest element, r.size() if r is empty
+    //   min_element(first, last)   iterator versions of argmin/argmax (std::min_element for other iterators)
+    //   max_element(first, last)
+    //
+    // NaNs are skipped, as if they were not there. A range of nothing but NaNs gives its first element.
+
+    template <typename T>
+    concept arithmetic = std::is_arithmetic_v<T>;
+
+    namespace detail
+    {
+        // a < b, exactly, for integers of any signedness
+        template <typename A, typename B>
+        constexpr bool
+        less(A a, B b)
+        {
+            if constexpr (std::is_integral_v<A> && std::is_integral_v<B> && std::is_signed_v<A> != std::is_signed_v<B>)
+            {
+                if constexpr (std::is_signed_v<A>)
+                {
+                    return a < 0 || static_cast<std::make_unsigned_t<A>>(a) < b;
+                }
+                else
+                {
+                    return b >= 0 && a < static_cast<std::make_unsigned_t<B>>(b);
+                }
+            }
+            else
+            {
+                return a < b;
+            }
+        }
+
+        template <typename A, typename B>
+        using max_t = std::common_type_t<A, B>;
+
+        // The minimum of a signed and an unsigned integer is at most the signed one, so it fits the signed version
+        // of their common type.
+        template <typename A, typename B, typename C = std::common_type_t<A, B>,
+                  bool = std::is_integral_v<A> && std::is_integral_v<B> && std::is_signed_v<A> != std::is_signed_v<B> &&
+                         std::is_unsigned_v<C>>
+        struct min_type
+        {
+            using type = C;
+        };
+
+        template <typename A, typename B, typename C>
+        struct min_type<A, B, C, true>
+        {
+            using type = std::make_signed_t<C>;
+        };
+
+        template <typename A, typename B>
+        using min_t = typename min_type<A, B>::type;
+
+    } // namespace detail
+
+    template <arithmetic A, arithmetic B>
+    constexpr detail::max_t<A, B>
+    max(A a, B b)
+    {
+        using R = detail::max_t<A, B>;
+        return detail::less(a, b) ? static_cast<R>(b) : static_cast<R>(a);
+    }
+
+    template <arithmetic A, arithmetic B>
+    constexpr detail::min_t<A, B>
+    min(A a, B b)
+    {
+        using R = detail::min_t<A, B>;
+        return detail::less(b, a) ? static_cast<R>(b) : static_cast<R>(a);
+    }
+
+    template <arithmetic A, arithmetic B>
+    constexpr std::pair<detail::min_t<A, B>, detail::max_t<A, B>>
+    minmax(A a, B b)
+    {
+        return {min(a, b), max(a, b)};
+    }
+
+    // lo must not be greater than hi (as for std::clamp)
+    template <arithmetic T, arithmetic L, arithmetic H>
+    constexpr auto
+    clamp(T v, L lo, H hi)
+    {
+        return min(max(v, lo), hi);
+    }
+
+    namespace detail
+    {
+        // Kernels only look at the representation, so e.g. `long` and `long long` share the 64-bit kernel.
+        template <typename T>
+        constexpr bool has_simd_kernel = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+                                         !std::is_same_v<T, long double>;
+
+        // what a min (max) reduction starts from: every value, NaN aside, compares <= (>=) to it
+        template <typename T>
+        constexpr T
+        highest()
+        {
+            return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                         : std::numeric_limits<T>::max();
+        }
+
+        template <typename T>
+        constexpr T
+        lowest()
+        {
+            return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                         : std::numeric_limits<T>::lowest();
+        }
+
+        // Folds p[0, n) into lo (if Min) and hi (if Max). `x < lo ? x : lo` is false for a NaN x, which is how NaNs
+        // get skipped, and it is exactly what minps/maxps compute.
+        //
+        // Written once with GCC vector extensions, Bytes wide (0: scalar only), and always inlined into the
+        // per-ISA wrappers below, whose target attribute decides the instructions.
+        template <std::size_t Bytes, bool Min, bool Max, typename T>
+        [[gnu::always_inline]] inline void
+        fold(const T *p, std::size_t n, T &lo, T &hi)
+        {
+            std::size_t i = 0;
+            if constexpr (Bytes > 0)
+            {
+                typedef T             vec __attribute__((vector_size(Bytes)));
+                constexpr std::size_t lanes = Bytes / sizeof(T);
+                constexpr std::size_t k     = 4; // independent accumulators, to hide the compare/blend latency
+
+                vec vlo[k], vhi[k];
+                for (std::size_t a = 0; a < k; a++)
+                {
+                    vlo[a] = vec{} + lo;
+                    vhi[a] = vec{} + hi;
+                }
+                for (; i + k * lanes <= n; i += k * lanes)
+                {
+                    for (std::size_t a = 0; a < k; a++)
+                    {
+                        vec x;
+                        std::memcpy(&x, p + i + a * lanes, sizeof x);
+                        if constexpr (Min)
+                        {
+                            vlo[a] = x < vlo[a] ? x : vlo[a];
+                        }
+                        if constexpr (Max)
+                        {
+                            vhi[a] = vhi[a] < x ? x : vhi[a];
+                        }
+                    }
+                }
+                for (std::size_t a = 0; a < k; a++)
+                {
+                    for (std::size_t l = 0; l < lanes; l++)
+                    {
+                        lo = vlo[a][l] < lo ? vlo[a][l] : lo;
+                        hi = hi < vhi[a][l] ? vhi[a][l] : hi;
+                    }
+                }
+            }
+            for (; i < n; i++)
+            {
+                if constexpr (Min)
+                {
+                    lo = p[i] < lo ? p[i] : lo;
+                }
+                if constexpr (Max)
+                {
+                    hi = hi < p[i] ? p[i] : hi;
+                }
+            }
+        }
+
+        template <bool Min, bool Max, typename T>
+        void
+        fold_scalar(const T *p, std::size_t n, T &lo, T &hi)
+        {
+            fold<0, Min, Max>(p, n, lo, hi);
+        }
+
+#if MYABS_X86
+        template <bool Min, bool Max, typename T>
+        __attribute__((target("sse2"))) void
+        fold_sse2(const T *p, std::size_t n, T &lo, T &hi)
+        {
+            fold<16, Min, Max>(p, n, lo, hi);
+        }
+
+        template <bool Min, bool Max, typename T>
+        __attribute__((target("avx2"))) void
+        fold_avx2(const T *p, std::size_t n, T &lo, T &hi)
+        {
+            fold<32, Min, Max>(p, n, lo, hi);
+        }
+
+        template <bool Min, bool Max, typename T>
+        __attribute__((target("avx512f,avx512bw"))) void
+        fold_avx512(const T *p, std::size_t n, T &lo, T &hi)
+        {
+            fold<64, Min, Max>(p, n, lo, hi);
+        }
+#endif
+
+        template <bool Min, bool Max, typename T>
+        void
+        fold_kernel(function_templates::detail::isa level, const T *p, std::size_t n, T &lo, T &hi)
+        {
+            using function_templates::detail::isa;
+#if MYABS_X86
+            if constexpr (has_simd_kernel<T>)
+            {
+                if (level == isa::avx512)
+                {
+                    return fold_avx512<Min, Max>(p, n, lo, hi);
+                }
+                else if (level == isa::avx2)
+                {
+                    return fold_avx2<Min, Max>(p, n, lo, hi);
+                }
+                else if (level == isa::sse2)
+                {
+                    return fold_sse2<Min, Max>(p, n, lo, hi);
+                }
+            }
+#else
+            (void)level;
+#endif
+            fold_scalar<Min, Max>(p, n, lo, hi);
+        }
+
+        template <typename T>
+        std::pair<T, T>
+        minmax_kernel(function_templates::detail::isa level, const T *p, std::size_t n)
+        {
+            T lo = highest<T>(), hi = lowest<T>();
+            fold_kernel<true, true>(level, p, n, lo, hi);
+            if (hi < lo) // nothing but NaNs
+            {
+                return {p[0], p[0]};
+            }
+            return {lo, hi};
+        }
+
+        // One pass over the data: the extreme of every block (vectorized), keeping the first block that holds the
+        // overall extreme. Only that block, which is still in L1, is scanned again for the index.
+        template <bool Max, typename T>
+        std::size_t
+        arg_kernel(function_templates::detail::isa level, const T *p, std::size_t n)
+        {
+            constexpr std::size_t block = 8192 / sizeof(T);
+
+            T           best       = Max ? lowest<T>() : highest<T>();
+            std::size_t best_block = 0;
+            for (std::size_t b = 0; b < n; b += block)
+            {
+                T lo = highest<T>(), hi = lowest<T>();
+                fold_kernel<!Max, Max>(level, p + b, std::min(block, n - b), lo, hi);
+                T m = Max ? hi : lo;
+                if (b == 0 || (Max ? best < m : m < best))
+                {
+                    best       = m;
+                    best_block = b;
+                }
+            }
+            // Normally found within the block. Only if the first blocks hold nothing but NaNs can `best` (an
+            // infinity) first appear further on.
+            for (std::size_t i = best_block; i < n; i++)
+            {
+                if (p[i] == best)
+                {
+                    return i;
+                }
+            }
+            return 0; // nothing but NaNs
+        }
+
+    } // namespace detail
+
+    template <std::ranges::contiguous_range R>
+        requires arithmetic<std::ranges::range_value_t<R>>
+    std::pair<std::ranges::range_value_t<R>, std::ranges::range_value_t<R>>
+    minmax(const R &r)
+    {
+        if (std::ranges::empty(r))
+        {
+            throw std::invalid_argument("extrema::minmax: empty range");
+        }
+        return detail::minmax_kernel(function_templates::detail::best_isa(), std::ranges::data(r),
+                                     std::ranges::size(r));
+    }
+
+    template <std::ranges::contiguous_range R>
+        requires arithmetic<std::ranges::range_value_t<R>>
+    std::size_t
+    argmin(const R &r)
+    {
+        std::size_t n = std::ranges::size(r);
+        return n ? detail::arg_kernel<false>(function_templates::detail::best_isa(), std::ranges::data(r), n) : n;
+    }
+
+    template <std::ranges::contiguous_range R>
+        requires arithmetic<std::ranges::range_value_t<R>>
+    std::size_t
+    argmax(const R &r)
+    {
+        std::size_t n = std::ranges::size(r);
+        return n ? detail::arg_kernel<true>(function_templates::detail::best_isa(), std::ranges::data(r), n) : n;
+    }
+
+    template <std::forward_iterator It>
+    It
+    min_element(It first, It last)
+    {
+        if constexpr (std::contiguous_iterator<It> && arithmetic<std::iter_value_t<It>>)
+        {
+            return first + static_cast<std::iter_difference_t<It>>(
+                               argmin(std::span(std::to_address(first), static_cast<std::size_t>(last - first))));
+        }
+        else
+        {
+            return std::min_element(first, last);
+        }
+    }
+
+    template <std::forward_iterator It>
+    It
+    max_element(It first, It last)
+    {
+        if constexpr (std::contiguous_iterator<It> && arithmetic<std::iter_value_t<It>>)
+        {
+            return first + static_cast<std::iter_difference_t<It>>(
+                               argmax(std::span(std::to_address(first), static_cast<std::size_t>(last - first))));
+        }
+        else
+        {
+            return std::max_element(first, last);
+        }
+    }
+
+} // namespace extrema
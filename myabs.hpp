@@ -0,0 +1,355 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MYABS_X86 1
+#else
+#define MYABS_X86 0
+#endif
+
+namespace function_templates
+{
+    // Templates are cookie cutters.
+    // You don't pay for what you don't use.
+
+    template <typename T>
+    T
+    myabs(T x)
+    {
+        return (x >= 0) ? x : -x;
+    }
+
+    // Batch form: the same cookie cutter applied to a whole contiguous range at once.
+    // Signed integers wrap on their minimum value (abs(INT_MIN) == INT_MIN) instead of overflowing, and floating
+    // point values keep the scalar semantics exactly (-0.0 stays -0.0, NaN gets its sign flipped).
+
+    namespace detail
+    {
+        enum class isa
+        {
+            scalar,
+            sse2,
+            avx2,
+            avx512, // F + BW
+        };
+
+        // Kernels only look at the bit pattern, so e.g. `long` and `long long` share the 64-bit kernel.
+        template <typename T>
+        constexpr bool has_simd_kernel = (std::is_integral_v<T> && std::is_signed_v<T>) || //
+                                         std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+        template <typename T>
+        T
+        myabs_wrap(T x)
+        {
+            if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            {
+                using U = std::make_unsigned_t<T>;
+                return (x >= 0) ? x : static_cast<T>(U(0) - static_cast<U>(x));
+            }
+            else
+            {
+                return myabs(x);
+            }
+        }
+
+        // scalar tail (and the whole range on non-x86 targets)
+        template <typename T>
+        void
+        myabs_scalar(const T *in, T *out, std::size_t n)
+        {
+            for (std::size_t i = 0; i < n; i++)
+            {
+                out[i] = myabs_wrap(in[i]);
+            }
+        }
+
+#if MYABS_X86
+        // Every kernel handles the full vectors and returns how many elements it processed.
+
+        template <typename T>
+        __attribute__((target("sse2"))) std::size_t
+        myabs_sse2(const T *in, T *out, std::size_t n)
+        {
+            constexpr std::size_t lanes = 16 / sizeof(T);
+            std::size_t           i     = 0;
+            for (; i + lanes <= n; i += lanes)
+            {
+                if constexpr (std::is_same_v<T, float>)
+                {
+                    __m128 x   = _mm_loadu_ps(in + i);
+                    __m128 pos = _mm_cmpge_ps(x, _mm_setzero_ps());
+                    __m128 neg = _mm_xor_ps(x, _mm_set1_ps(-0.0f));
+                    _mm_storeu_ps(out + i, _mm_or_ps(_mm_and_ps(pos, x), _mm_andnot_ps(pos, neg)));
+                }
+                else if constexpr (std::is_same_v<T, double>)
+                {
+                    __m128d x   = _mm_loadu_pd(in + i);
+                    __m128d pos = _mm_cmpge_pd(x, _mm_setzero_pd());
+                    __m128d neg = _mm_xor_pd(x, _mm_set1_pd(-0.0));
+                    _mm_storeu_pd(out + i, _mm_or_pd(_mm_and_pd(pos, x), _mm_andnot_pd(pos, neg)));
+                }
+                else
+                {
+                    // SSE2 has no pabs: abs(x) = (x ^ m) - m with m = all ones in negative lanes
+                    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+                    __m128i m;
+                    if constexpr (sizeof(T) == 1)
+                    {
+                        m = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+                    }
+                    else if constexpr (sizeof(T) == 2)
+                    {
+                        m = _mm_srai_epi16(x, 15);
+                    }
+                    else if constexpr (sizeof(T) == 4)
+                    {
+                        m = _mm_srai_epi32(x, 31);
+                    }
+                    else
+                    {
+                        m = _mm_shuffle_epi32(_mm_srai_epi32(x, 31), _MM_SHUFFLE(3, 3, 1, 1));
+                    }
+                    __m128i r = _mm_xor_si128(x, m);
+                    if constexpr (sizeof(T) == 1)
+                    {
+                        r = _mm_sub_epi8(r, m);
+                    }
+                    else if constexpr (sizeof(T) == 2)
+                    {
+                        r = _mm_sub_epi16(r, m);
+                    }
+                    else if constexpr (sizeof(T) == 4)
+                    {
+                        r = _mm_sub_epi32(r, m);
+                    }
+                    else
+                    {
+                        r = _mm_sub_epi64(r, m);
+                    }
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), r);
+                }
+            }
+            return i;
+        }
+
+        template <typename T>
+        __attribute__((target("avx2"))) std::size_t
+        myabs_avx2(const T *in, T *out, std::size_t n)
+        {
+            constexpr std::size_t lanes = 32 / sizeof(T);
+            std::size_t           i     = 0;
+            for (; i + lanes <= n; i += lanes)
+            {
+                if constexpr (std::is_same_v<T, float>)
+                {
+                    __m256 x   = _mm256_loadu_ps(in + i);
+                    __m256 pos = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GE_OQ);
+                    __m256 neg = _mm256_xor_ps(x, _mm256_set1_ps(-0.0f));
+                    _mm256_storeu_ps(out + i, _mm256_blendv_ps(neg, x, pos));
+                }
+                else if constexpr (std::is_same_v<T, double>)
+                {
+                    __m256d x   = _mm256_loadu_pd(in + i);
+                    __m256d pos = _mm256_cmp_pd(x, _mm256_setzero_pd(), _CMP_GE_OQ);
+                    __m256d neg = _mm256_xor_pd(x, _mm256_set1_pd(-0.0));
+                    _mm256_storeu_pd(out + i, _mm256_blendv_pd(neg, x, pos));
+                }
+                else
+                {
+                    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+                    __m256i r;
+                    if constexpr (sizeof(T) == 1)
+                    {
+                        r = _mm256_abs_epi8(x);
+                    }
+                    else if constexpr (sizeof(T) == 2)
+                    {
+                        r = _mm256_abs_epi16(x);
+                    }
+                    else if constexpr (sizeof(T) == 4)
+                    {
+                        r = _mm256_abs_epi32(x);
+                    }
+                    else
+                    {
+                        // no vpabsq before AVX-512
+                        __m256i m = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+                        r         = _mm256_sub_epi64(_mm256_xor_si256(x, m), m);
+                    }
+                    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), r);
+                }
+            }
+            return i;
+        }
+
+        template <typename T>
+        __attribute__((target("avx512f,avx512bw"))) std::size_t
+        myabs_avx512(const T *in, T *out, std::size_t n)
+        {
+            constexpr std::size_t lanes = 64 / sizeof(T);
+            std::size_t           i     = 0;
+            for (; i + lanes <= n; i += lanes)
+            {
+                if constexpr (std::is_same_v<T, float>)
+                {
+                    __m512    x   = _mm512_loadu_ps(in + i);
+                    __mmask16 pos = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_GE_OQ);
+                    __m512    neg = _mm512_castsi512_ps(
+                        _mm512_xor_si512(_mm512_castps_si512(x), _mm512_set1_epi32(static_cast<int>(0x80000000u))));
+                    _mm512_storeu_ps(out + i, _mm512_mask_blend_ps(pos, neg, x));
+                }
+                else if constexpr (std::is_same_v<T, double>)
+                {
+                    __m512d  x   = _mm512_loadu_pd(in + i);
+                    __mmask8 pos = _mm512_cmp_pd_mask(x, _mm512_setzero_pd(), _CMP_GE_OQ);
+                    __m512d  neg = _mm512_castsi512_pd(_mm512_xor_si512(
+                        _mm512_castpd_si512(x), _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull))));
+                    _mm512_storeu_pd(out + i, _mm512_mask_blend_pd(pos, neg, x));
+                }
+                else
+                {
+                    __m512i x = _mm512_loadu_si512(in + i);
+                    // NOTE: the zero-masking forms with a full mask, because GCC 12 warns about the
+                    // _mm512_undefined_*() passthrough inside the plain _mm512_abs_* intrinsics.
+                    __m512i r;
+                    if constexpr (sizeof(T) == 1)
+                    {
+                        r = _mm512_maskz_abs_epi8(~__mmask64(0), x);
+                    }
+                    else if constexpr (sizeof(T) == 2)
+                    {
+                        r = _mm512_maskz_abs_epi16(~__mmask32(0), x);
+                    }
+                    else if constexpr (sizeof(T) == 4)
+                    {
+                        r = _mm512_maskz_abs_epi32(~__mmask16(0), x);
+                    }
+                    else
+                    {
+                        r = _mm512_maskz_abs_epi64(~__mmask8(0), x);
+                    }
+                    _mm512_storeu_si512(out + i, r);
+                }
+            }
+            return i;
+        }
+
+        inline isa
+        detect_isa()
+        {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+            {
+                return isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return isa::avx2;
+            }
+            if (__builtin_cpu_supports("sse2"))
+            {
+                return isa::sse2;
+            }
+            return isa::scalar;
+        }
+#else
+        inline isa
+        detect_isa()
+        {
+            return isa::scalar;
+        }
+#endif
+
+        // CPU detection runs once, on first use.
+        inline isa
+        best_isa()
+        {
+            static const isa best = detect_isa();
+            return best;
+        }
+
+        // Runs the widest kernel not wider than `level` and finishes the remainder with the scalar tail.
+        // `in` and `out` may be the same range (in-place), but must not partially overlap.
+        template <typename T>
+        void
+        myabs_kernel(isa level, const T *in, T *out, std::size_t n)
+        {
+            std::size_t done = 0;
+#if MYABS_X86
+            if constexpr (has_simd_kernel<T>)
+            {
+                if (level == isa::avx512)
+                {
+                    done = myabs_avx512(in, out, n);
+                }
+                else if (level == isa::avx2)
+                {
+                    done = myabs_avx2(in, out, n);
+                }
+                else if (level == isa::sse2)
+                {
+                    done = myabs_sse2(in, out, n);
+                }
+            }
+#else
+            (void)level;
+#endif
+            myabs_scalar(in + done, out + done, n - done);
+        }
+
+    } // namespace detail
+
+    // NOTE: `in` is a non-deduced context (std::type_identity_t), so T is deduced from `out` alone and a
+    // `std::span<T>` converts to `std::span<const T>` without a deduction failure.
+    template <typename T>
+    void
+    myabs(std::type_identity_t<std::span<const T>> in, std::span<T> out)
+    {
+        if (out.size() < in.size())
+        {
+            throw std::length_error("myabs: output range is smaller than input range");
+        }
+        detail::myabs_kernel(detail::best_isa(), in.data(), out.data(), in.size());
+    }
+
+    // in-place
+    // NOTE: more specialized than `myabs(T)`, so partial ordering picks this one for spans.
+    template <typename T>
+    void
+    myabs(std::span<T> inout)
+    {
+        detail::myabs_kernel(detail::best_isa(), inout.data(), inout.data(), inout.size());
+    }
+
+    // iterator pair (like std::transform); contiguous ranges of the same element type take the SIMD path
+    template <typename InIt, typename OutIt>
+    OutIt
+    myabs(InIt first, InIt last, OutIt d_first)
+    {
+        using T = std::iter_value_t<InIt>;
+        if constexpr (std::contiguous_iterator<InIt> && std::contiguous_iterator<OutIt> &&
+                      std::is_same_v<T, std::iter_value_t<OutIt>>)
+        {
+            auto n = static_cast<std::size_t>(last - first);
+            detail::myabs_kernel(detail::best_isa(), std::to_address(first), std::to_address(d_first), n);
+            return d_first + static_cast<std::iter_difference_t<OutIt>>(n);
+        }
+        else
+        {
+            for (; first != last; ++first, ++d_first)
+            {
+                *d_first = detail::myabs_wrap(*first);
+            }
+            return d_first;
+        }
+    }
+
+} // namespace function_templates
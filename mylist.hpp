@@ -0,0 +1,743 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace class_templates
+{
+    // mylist<T> started out as a bare node { T data; mylist<T> *next; }, i.e. one cache miss per element.
+    // Now it is an unrolled doubly-linked list: every node is a whole number of cache lines holding up to N
+    // elements contiguously, and released nodes go to a per-list freelist to be reused.
+    //
+    // Iterator invalidation (unlike std::list): insertion into a full node and erasure may move elements around
+    // inside their node and its neighbors, so they invalidate iterators into those nodes. splice() relinks whole
+    // nodes and never moves elements, except that it may split the nodes at the splice points.
+
+    constexpr std::size_t cache_line = 64;
+
+    namespace detail
+    {
+        struct list_node_base
+        {
+            list_node_base *next;
+            list_node_base *prev;
+            std::size_t     count; // always 0 for the sentinel
+        };
+
+        // smallest whole number of cache lines holding at least 8 elements
+        template <typename T>
+        constexpr std::size_t
+        default_node_capacity()
+        {
+            std::size_t lines = 1;
+            while ((lines * cache_line - sizeof(list_node_base)) / sizeof(T) < 8)
+            {
+                lines++;
+            }
+            return (lines * cache_line - sizeof(list_node_base)) / sizeof(T);
+        }
+
+        template <typename T, std::size_t N>
+        struct alignas(cache_line) list_node : list_node_base
+        {
+            alignas(T) unsigned char storage[N * sizeof(T)];
+
+            T *
+            data()
+            {
+                return std::launder(reinterpret_cast<T *>(storage));
+            }
+        };
+
+    } // namespace detail
+
+    template <typename T, std::size_t N = detail::default_node_capacity<T>()>
+    class mylist;
+
+    template <typename T, std::size_t N, bool Const>
+    class mylist_iterator
+    {
+        using node_base = detail::list_node_base;
+        using node      = detail::list_node<T, N>;
+
+      public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T *, T *>;
+        using reference         = std::conditional_t<Const, const T &, T &>;
+        using supports_plus     = std::false_type; // see good_tag_dispatch
+        using supports_segments = std::true_type;  // see segmented.hpp
+
+        mylist_iterator() = default;
+
+        // iterator -> const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        mylist_iterator(const mylist_iterator<T, N, false> &other) : node_(other.node_), index_(other.index_)
+        {
+        }
+
+        reference
+        operator*() const
+        {
+            return static_cast<node *>(node_)->data()[index_];
+        }
+
+        pointer
+        operator->() const
+        {
+            return &**this;
+        }
+
+        mylist_iterator &
+        operator++()
+        {
+            // usually just an index bump inside the node
+            if (++index_ == node_->count)
+            {
+                node_  = node_->next;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        mylist_iterator
+        operator++(int)
+        {
+            mylist_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        mylist_iterator &
+        operator--()
+        {
+            if (index_ == 0)
+            {
+                node_  = node_->prev;
+                index_ = node_->count;
+            }
+            --index_;
+            return *this;
+        }
+
+        mylist_iterator
+        operator--(int)
+        {
+            mylist_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        // segmented iterator protocol (see segmented.hpp): a segment is the contiguous run of elements in one node
+
+        // elements from here to the end of the node (or to `last` if that comes first)
+        std::span<std::conditional_t<Const, const T, T>>
+        segment() const
+        {
+            return {&**this, node_->count - index_};
+        }
+
+        std::span<std::conditional_t<Const, const T, T>>
+        segment_until(const mylist_iterator &last) const
+        {
+            return same_segment(last) ? segment().first(last.index_ - index_) : segment();
+        }
+
+        bool
+        same_segment(const mylist_iterator &other) const
+        {
+            return node_ == other.node_;
+        }
+
+        mylist_iterator
+        next_segment() const
+        {
+            return mylist_iterator(node_->next, 0);
+        }
+
+        // k elements further, staying inside the segment
+        mylist_iterator
+        local_advance(std::size_t k) const
+        {
+            return k == node_->count - index_ ? next_segment() : mylist_iterator(node_, index_ + k);
+        }
+
+        friend bool
+        operator==(const mylist_iterator &a, const mylist_iterator &b)
+        {
+            return a.node_ == b.node_ && a.index_ == b.index_;
+        }
+
+      private:
+        friend class mylist<T, N>;
+        friend class mylist_iterator<T, N, !Const>;
+
+        mylist_iterator(node_base *n, std::size_t i) : node_(n), index_(i)
+        {
+        }
+
+        node_base  *node_{};
+        std::size_t index_{};
+    };
+
+    template <typename T, std::size_t N>
+    class mylist
+    {
+        static_assert(N > 0);
+
+        using node_base = detail::list_node_base;
+        using node      = detail::list_node<T, N>;
+
+      public:
+        using value_type      = T;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference       = T &;
+        using const_reference = const T &;
+        using iterator        = mylist_iterator<T, N, false>;
+        using const_iterator  = mylist_iterator<T, N, true>;
+
+        static constexpr std::size_t node_capacity = N;
+
+        mylist()
+        {
+        }
+
+        mylist(std::initializer_list<T> init)
+        {
+            for (const T &x : init)
+            {
+                push_back(x);
+            }
+        }
+
+        mylist(const mylist &other)
+        {
+            for (const T &x : other)
+            {
+                push_back(x);
+            }
+        }
+
+        mylist(mylist &&other) noexcept
+        {
+            steal(other);
+        }
+
+        mylist &
+        operator=(const mylist &other)
+        {
+            if (this != &other)
+            {
+                mylist tmp(other);
+                clear();
+                steal(tmp);
+            }
+            return *this;
+        }
+
+        mylist &
+        operator=(mylist &&other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                steal(other);
+            }
+            return *this;
+        }
+
+        ~mylist()
+        {
+            clear();
+            shrink_to_fit();
+        }
+
+        // iterators
+
+        iterator
+        begin()
+        {
+            return iterator(head_.next, 0);
+        }
+
+        iterator
+        end()
+        {
+            return iterator(&head_, 0);
+        }
+
+        const_iterator
+        begin() const
+        {
+            return const_iterator(head_.next, 0);
+        }
+
+        const_iterator
+        end() const
+        {
+            return const_iterator(const_cast<node_base *>(&head_), 0);
+        }
+
+        const_iterator
+        cbegin() const
+        {
+            return begin();
+        }
+
+        const_iterator
+        cend() const
+        {
+            return end();
+        }
+
+        // capacity
+
+        bool
+        empty() const
+        {
+            return size_ == 0;
+        }
+
+        size_type
+        size() const
+        {
+            return size_;
+        }
+
+        // element access
+
+        T &
+        front()
+        {
+            return *begin();
+        }
+
+        const T &
+        front() const
+        {
+            return *begin();
+        }
+
+        T &
+        back()
+        {
+            return *--end();
+        }
+
+        const T &
+        back() const
+        {
+            return *--end();
+        }
+
+        // modifiers
+
+        void
+        push_back(const T &x)
+        {
+            emplace_back(x);
+        }
+
+        void
+        push_back(T &&x)
+        {
+            emplace_back(std::move(x));
+        }
+
+        void
+        push_front(const T &x)
+        {
+            emplace_front(x);
+        }
+
+        void
+        push_front(T &&x)
+        {
+            emplace_front(std::move(x));
+        }
+
+        template <typename... Args>
+        T &
+        emplace_back(Args &&...args)
+        {
+            node_base *tail = head_.prev;
+            if (tail == &head_ || tail->count == N)
+            {
+                tail = link_before(&head_, allocate_node());
+            }
+            node *n = static_cast<node *>(tail);
+            T    *p = ::new (static_cast<void *>(n->data() + n->count)) T(std::forward<Args>(args)...);
+            n->count++;
+            size_++;
+            return *p;
+        }
+
+        template <typename... Args>
+        T &
+        emplace_front(Args &&...args)
+        {
+            return *emplace(begin(), std::forward<Args>(args)...);
+        }
+
+        template <typename... Args>
+        iterator
+        emplace(const_iterator pos, Args &&...args)
+        {
+            node_base  *n = pos.node_;
+            std::size_t i = pos.index_;
+
+            if (n == &head_)
+            {
+                node_base *tail = head_.prev;
+                if (tail == &head_ || tail->count == N)
+                {
+                    return emplace_new_node(&head_, std::forward<Args>(args)...);
+                }
+                return emplace_at(tail, tail->count, std::forward<Args>(args)...);
+            }
+            if (i == 0 && n->prev != &head_ && n->prev->count < N)
+            {
+                // room at the end of the previous node: append there instead of shifting this one
+                return emplace_at(n->prev, n->prev->count, std::forward<Args>(args)...);
+            }
+            if (n->count == N)
+            {
+                // construct first: `args` may refer to an element that the split moves away
+                T          tmp(std::forward<Args>(args)...);
+                node_base *right = split(n, N / 2);
+                if (i > N / 2)
+                {
+                    n = right;
+                    i -= N / 2;
+                }
+                return emplace_at(n, i, std::move(tmp));
+            }
+            return emplace_at(n, i, std::forward<Args>(args)...);
+        }
+
+        iterator
+        insert(const_iterator pos, const T &x)
+        {
+            return emplace(pos, x);
+        }
+
+        iterator
+        insert(const_iterator pos, T &&x)
+        {
+            return emplace(pos, std::move(x));
+        }
+
+        void
+        pop_back()
+        {
+            erase(--end());
+        }
+
+        void
+        pop_front()
+        {
+            erase(begin());
+        }
+
+        iterator
+        erase(const_iterator pos)
+        {
+            node_base  *n    = pos.node_;
+            std::size_t i    = pos.index_;
+            T          *data = static_cast<node *>(n)->data();
+
+            std::move(data + i + 1, data + n->count, data + i);
+            std::destroy_at(data + n->count - 1);
+            n->count--;
+            size_--;
+
+            if (n->count == 0)
+            {
+                node_base *next = n->next;
+                unlink(n);
+                release_node(n);
+                return iterator(next, 0);
+            }
+            // keep nodes reasonably full: merge a sparse node with its successor when both fit into one
+            if (n->count < N / 4 && n->next != &head_ && n->count + n->next->count <= N / 2)
+            {
+                merge_next(n);
+            }
+            return i == n->count ? iterator(n->next, 0) : iterator(n, i);
+        }
+
+        iterator
+        erase(const_iterator first, const_iterator last)
+        {
+            // erase() returns the iterator to the next element, which is all we need to keep going
+            std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+            iterator    it(first.node_, first.index_);
+            for (; n > 0; n--)
+            {
+                it = erase(it);
+            }
+            return it;
+        }
+
+        void
+        clear()
+        {
+            node_base *n = head_.next;
+            while (n != &head_)
+            {
+                node_base *next = n->next;
+                std::destroy_n(static_cast<node *>(n)->data(), n->count);
+                release_node(n);
+                n = next;
+            }
+            head_.next = head_.prev = &head_;
+            size_                   = 0;
+        }
+
+        // Gives the nodes on the freelist back to the system.
+        void
+        shrink_to_fit()
+        {
+            while (free_ != nullptr)
+            {
+                node_base *next = free_->next;
+                ::operator delete(static_cast<void *>(free_), std::align_val_t{alignof(node)});
+                free_ = next;
+            }
+        }
+
+        // Moves all elements of `other` before `pos`; nodes are relinked, not copied.
+        void
+        splice(const_iterator pos, mylist &other)
+        {
+            if (&other == this || other.empty())
+            {
+                return;
+            }
+            node_base *at = split_at(pos);
+            transfer(at, other.head_.next, other.head_.prev);
+            size_ += other.size_;
+            other.head_.next = other.head_.prev = &other.head_;
+            other.size_                         = 0;
+        }
+
+        void
+        splice(const_iterator pos, mylist &&other)
+        {
+            splice(pos, other);
+        }
+
+        // Moves [first, last) of `other` before `pos`. `other` may be *this; then nothing happens if `pos` is in
+        // [first, last] (std::list leaves a `pos` inside the range undefined).
+        void
+        splice(const_iterator pos, mylist &other, const_iterator first, const_iterator last)
+        {
+            if (first == last)
+            {
+                return;
+            }
+            // Split at `last`, then `first`, then `pos`. A split moves the tail of a node into a new one, so the
+            // iterators still to be split are moved along with their elements when they are in the same list.
+            node_base *stop = other.split_at(last);
+            if (&other == this)
+            {
+                pos = follow_split(pos, last, stop);
+            }
+            node_base *start = other.split_at(first);
+            if (&other == this)
+            {
+                pos = follow_split(pos, first, start);
+            }
+            node_base *at = split_at(pos);
+
+            std::size_t moved = 0;
+            for (node_base *n = start; n != stop; n = n->next)
+            {
+                if (n == at)
+                {
+                    return; // same list, `pos` inside the range: it is where it should go already
+                }
+                moved += n->count;
+            }
+            if (at == stop)
+            {
+                return; // right before `last`: ditto
+            }
+            transfer(at, start, stop->prev);
+            other.size_ -= moved;
+            size_ += moved;
+        }
+
+        void
+        splice(const_iterator pos, mylist &&other, const_iterator first, const_iterator last)
+        {
+            splice(pos, other, first, last);
+        }
+
+      private:
+        node_base *
+        allocate_node()
+        {
+            node_base *n;
+            if (free_ != nullptr)
+            {
+                n     = free_;
+                free_ = free_->next;
+            }
+            else
+            {
+                n = static_cast<node_base *>(static_cast<node *>(
+                    ::new (::operator new(sizeof(node), std::align_val_t{alignof(node)})) node));
+            }
+            n->next = n->prev = nullptr;
+            n->count          = 0;
+            return n;
+        }
+
+        void
+        release_node(node_base *n)
+        {
+            n->next = free_;
+            free_   = n;
+        }
+
+        node_base *
+        link_before(node_base *pos, node_base *n)
+        {
+            n->next         = pos;
+            n->prev         = pos->prev;
+            pos->prev->next = n;
+            pos->prev       = n;
+            return n;
+        }
+
+        static void
+        unlink(node_base *n)
+        {
+            n->prev->next = n->next;
+            n->next->prev = n->prev;
+        }
+
+        // Moves elements [at, count) of `n` into a new node right after it and returns the new node.
+        node_base *
+        split(node_base *n, std::size_t at)
+        {
+            node_base *right = link_before(n->next, allocate_node());
+            T         *from  = static_cast<node *>(n)->data();
+            T         *to    = static_cast<node *>(right)->data();
+            std::uninitialized_move(from + at, from + n->count, to);
+            std::destroy(from + at, from + n->count);
+            right->count = n->count - at;
+            n->count     = at;
+            return right;
+        }
+
+        // Where `it` is after split_at(pos) returned `right`: elements from pos on moved to `right`.
+        static const_iterator
+        follow_split(const_iterator it, const_iterator pos, node_base *right)
+        {
+            if (pos.index_ != 0 && it.node_ == pos.node_ && it.index_ >= pos.index_)
+            {
+                return const_iterator(right, it.index_ - pos.index_);
+            }
+            return it;
+        }
+
+        // Makes `pos` the first element of its node and returns that node (the sentinel for end()).
+        node_base *
+        split_at(const_iterator pos)
+        {
+            return pos.index_ == 0 ? pos.node_ : split(pos.node_, pos.index_);
+        }
+
+        void
+        merge_next(node_base *n)
+        {
+            node_base *next = n->next;
+            T         *to   = static_cast<node *>(n)->data();
+            T         *from = static_cast<node *>(next)->data();
+            std::uninitialized_move(from, from + next->count, to + n->count);
+            std::destroy(from, from + next->count);
+            n->count += next->count;
+            unlink(next);
+            release_node(next);
+        }
+
+        // Relinks the node chain [first, last] (unlinked from wherever it is) before `pos`.
+        static void
+        transfer(node_base *pos, node_base *first, node_base *last)
+        {
+            first->prev->next = last->next;
+            last->next->prev  = first->prev;
+
+            first->prev     = pos->prev;
+            last->next      = pos;
+            pos->prev->next = first;
+            pos->prev       = last;
+        }
+
+        template <typename... Args>
+        iterator
+        emplace_new_node(node_base *pos, Args &&...args)
+        {
+            node_base *n = link_before(pos, allocate_node());
+            ::new (static_cast<void *>(static_cast<node *>(n)->data())) T(std::forward<Args>(args)...);
+            n->count = 1;
+            size_++;
+            return iterator(n, 0);
+        }
+
+        // `n` has room; shifts [i, count) one slot to the right and constructs the new element at i.
+        template <typename... Args>
+        iterator
+        emplace_at(node_base *n, std::size_t i, Args &&...args)
+        {
+            T *data = static_cast<node *>(n)->data();
+            if (i == n->count)
+            {
+                ::new (static_cast<void *>(data + i)) T(std::forward<Args>(args)...);
+            }
+            else
+            {
+                T tmp(std::forward<Args>(args)...);
+                ::new (static_cast<void *>(data + n->count)) T(std::move(data[n->count - 1]));
+                std::move_backward(data + i, data + n->count - 1, data + n->count);
+                data[i] = std::move(tmp);
+            }
+            n->count++;
+            size_++;
+            return iterator(n, i);
+        }
+
+        void
+        steal(mylist &other)
+        {
+            if (other.head_.next != &other.head_)
+            {
+                head_.next       = other.head_.next;
+                head_.prev       = other.head_.prev;
+                head_.next->prev = &head_;
+                head_.prev->next = &head_;
+            }
+            size_ = other.size_;
+            std::swap(free_, other.free_);
+
+            other.head_.next = other.head_.prev = &other.head_;
+            other.size_                         = 0;
+        }
+
+        node_base   head_{&head_, &head_, 0}; // sentinel of the circular node chain
+        std::size_t size_{};
+        node_base  *free_{}; // recycled nodes, linked through `next`
+    };
+
+} // namespace class_templates
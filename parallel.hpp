@@ -0,0 +1,761 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <semaphore>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "trace.hpp" // TRACE_SCOPE on the leaves
+
+namespace parallel
+{
+    // A work-stealing thread pool and parallel versions of for_each, transform, transform_reduce and inclusive_scan.
+    //
+    //   thread_pool pool(n);            n worker threads (default: one per hardware thread)
+    //   pool.run(f)                     runs f on a worker and waits for it
+    //   pool.join(f, g)                 runs f and g, possibly in parallel, and waits for both (fork-join)
+    //   for_each([pool,] first, last, f, grain = 0)   and likewise transform, transform_reduce, inclusive_scan
+    //
+    // Every worker has its own deque. join(f, g) pushes g on the worker's deque and runs f; idle workers steal
+    // from the other end of somebody's deque, which holds the oldest, i.e. largest, pieces of work. If nobody stole
+    // g, the worker pops it back and runs it itself, so an idle-free pool pays only a push and a pop per split. A
+    // worker waiting for a stolen g runs other tasks meanwhile instead of blocking.
+    //
+    // The algorithms pick their version by tag dispatch, like good_tag_dispatch::advance_impl:
+    //
+    //   std::true_type    random-access iterators: the range is split in halves, recursively, down to `grain`
+    //   std::false_type   anything else (mylist, tree, ...): one pass cuts the range into chunks of `grain`
+    //                     elements, then the chunks are processed in parallel
+    //
+    // Chunking walks the input twice, so a single-pass input (std::istream_iterator, ...) gets the serial std::
+    // algorithm instead, as does a single-pass output (std::back_inserter, ...).
+    //
+    // grain is the largest number of elements one task handles. 0 picks about 8 tasks per worker for random access
+    // and chunks of 1024 otherwise. Functions run concurrently on several threads, so they must not race (as with
+    // std::execution::par), and reductions must be associative. An exception thrown by any of them is rethrown by
+    // the algorithm once all tasks have finished.
+
+    namespace detail
+    {
+        struct task
+        {
+            explicit task(void (*execute_)(task *)) : execute(execute_)
+            {
+            }
+
+            void (*execute)(task *);
+            std::atomic<bool>      done{false};
+            std::exception_ptr     error;
+            std::binary_semaphore *signal = nullptr; // for a thread outside the pool waiting in run()
+        };
+
+        template <typename F>
+        struct closure : task
+        {
+            F f;
+
+            explicit closure(F f_) : task(&closure::run), f(std::move(f_))
+            {
+            }
+
+            static void
+            run(task *t)
+            {
+                auto *self = static_cast<closure *>(t);
+                try
+                {
+                    self->f();
+                }
+                catch (...)
+                {
+                    self->error = std::current_exception();
+                }
+                std::binary_semaphore *signal = self->signal; // *self may be gone once done is set
+                self->done.store(true, std::memory_order_release);
+                if (signal)
+                {
+                    signal->release();
+                }
+            }
+        };
+
+        // Owner pushes and pops at the back, thieves steal from the front. A mutex per deque: only thieves (rare)
+        // ever contend with the owner.
+        class alignas(64) task_deque
+        {
+          public:
+            void
+            push(task *t)
+            {
+                std::lock_guard lock(m_);
+                tasks_.push_back(t);
+            }
+
+            // pops t if it is still at the back, i.e. if nobody stole it
+            bool
+            pop(task *t)
+            {
+                std::lock_guard lock(m_);
+                if (!tasks_.empty() && tasks_.back() == t)
+                {
+                    tasks_.pop_back();
+                    return true;
+                }
+                return false;
+            }
+
+            task *
+            steal()
+            {
+                std::lock_guard lock(m_);
+                if (tasks_.empty())
+                {
+                    return nullptr;
+                }
+                task *t = tasks_.front();
+                tasks_.pop_front();
+                return t;
+            }
+
+          private:
+            std::mutex         m_;
+            std::deque<task *> tasks_;
+        };
+
+    } // namespace detail
+
+    class thread_pool;
+
+    namespace detail
+    {
+        // the pool and deque of the calling thread, if it is a worker; constant-initialized (no TLS guard)
+        struct worker_context
+        {
+            thread_pool *pool  = nullptr;
+            std::size_t  index = 0;
+        };
+
+        inline thread_local worker_context current;
+
+    } // namespace detail
+
+    class thread_pool
+    {
+      public:
+        explicit thread_pool(std::size_t threads = std::max(1u, std::thread::hardware_concurrency()))
+            : deques_(std::max<std::size_t>(threads, 1))
+        {
+            for (std::size_t i = 0; i < deques_.size(); i++)
+            {
+                workers_.emplace_back([this, i] { work(i); });
+            }
+        }
+
+        thread_pool(const thread_pool &) = delete;
+        thread_pool &
+        operator=(const thread_pool &) = delete;
+
+        ~thread_pool()
+        {
+            {
+                std::lock_guard lock(sleep_m_);
+                stop_ = true;
+            }
+            sleep_cv_.notify_all();
+            for (auto &w : workers_)
+            {
+                w.join();
+            }
+        }
+
+        std::size_t
+        size() const
+        {
+            return deques_.size();
+        }
+
+        // Runs f on one of the workers and waits for it (directly, if called from a worker of this pool).
+        template <typename F>
+        void
+        run(F f)
+        {
+            if (detail::current.pool == this)
+            {
+                f();
+                return;
+            }
+            std::binary_semaphore signal(0);
+            detail::closure<F>    root(std::move(f));
+            root.signal = &signal;
+            {
+                std::lock_guard lock(injected_m_);
+                injected_.push_back(&root);
+            }
+            notify();
+            signal.acquire();
+            if (root.error)
+            {
+                std::rethrow_exception(root.error);
+            }
+        }
+
+        // Runs f and g, possibly in parallel, and returns when both are done.
+        template <typename F, typename G>
+        void
+        join(F f, G g)
+        {
+            if (detail::current.pool != this)
+            {
+                run([&] { join(std::move(f), std::move(g)); });
+                return;
+            }
+            std::size_t        self = detail::current.index;
+            detail::closure<G> right(std::move(g));
+            deques_[self].push(&right);
+            notify();
+
+            std::exception_ptr error;
+            try
+            {
+                f();
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            if (deques_[self].pop(&right))
+            {
+                right.execute(&right);
+            }
+            else
+            {
+                // stolen: help with other work until the thief is done
+                while (!right.done.load(std::memory_order_acquire))
+                {
+                    if (detail::task *t = find(self))
+                    {
+                        t->execute(t);
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+            if (right.error)
+            {
+                std::rethrow_exception(right.error);
+            }
+        }
+
+      private:
+        void
+        notify()
+        {
+            pushes_.fetch_add(1);
+            if (sleeping_.load() > 0)
+            {
+                std::lock_guard lock(sleep_m_);
+                sleep_cv_.notify_one();
+            }
+        }
+
+        // Steals (oldest task first) from the other workers' deques, then takes an injected root. The worker's own
+        // deque is not searched: join() pops its own task back directly.
+        detail::task *
+        find(std::size_t self)
+        {
+            std::size_t n = deques_.size();
+            for (std::size_t k = 1; k < n; k++)
+            {
+                if (detail::task *t = deques_[(self + k) % n].steal())
+                {
+                    return t;
+                }
+            }
+            std::lock_guard lock(injected_m_);
+            if (injected_.empty())
+            {
+                return nullptr;
+            }
+            detail::task *t = injected_.front();
+            injected_.pop_front();
+            return t;
+        }
+
+        void
+        work(std::size_t self)
+        {
+            detail::current = {this, self};
+            while (true)
+            {
+                std::uint64_t seen = pushes_.load();
+                // A worker's own deque is empty here: whatever it pushes, it pops or waits for inside join().
+                for (int spin = 0; spin < 64; spin++)
+                {
+                    if (detail::task *t = find(self))
+                    {
+                        t->execute(t);
+                        seen = pushes_.load();
+                        spin = -1;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                // Nothing pushed since `seen` means nothing to find: sleep until the next push. notify() bumps
+                // pushes_ before reading sleeping_, and this bumps sleeping_ before reading pushes_, so one of
+                // them sees the other.
+                std::unique_lock lock(sleep_m_);
+                sleeping_.fetch_add(1);
+                sleep_cv_.wait(lock, [&] { return stop_ || pushes_.load() != seen; });
+                sleeping_.fetch_sub(1);
+                if (stop_)
+                {
+                    return;
+                }
+            }
+        }
+
+        std::vector<detail::task_deque> deques_;
+        std::vector<std::thread>        workers_;
+
+        std::mutex                 injected_m_;
+        std::deque<detail::task *> injected_; // run() from outside the pool
+
+        std::atomic<std::uint64_t> pushes_{0};
+        std::atomic<std::size_t>   sleeping_{0};
+        std::mutex                 sleep_m_;
+        std::condition_variable    sleep_cv_;
+        bool                       stop_ = false;
+    };
+
+    // shared by the algorithms called without a pool; created on first use
+    inline thread_pool &
+    default_pool()
+    {
+        static thread_pool pool;
+        return pool;
+    }
+
+    template <typename Iter>
+    using random_access_tag = std::bool_constant<std::random_access_iterator<Iter>>;
+
+    // for algorithms with an output: both ends must be random access
+    template <typename Iter, typename Out>
+    using random_access_tag2 =
+        std::bool_constant<std::random_access_iterator<Iter> && std::random_access_iterator<Out>>;
+
+    namespace detail
+    {
+        constexpr std::size_t chunked_grain = 1024;
+
+        inline std::size_t
+        auto_grain(const thread_pool &pool, std::size_t n, std::size_t grain)
+        {
+            return grain ? grain : std::max<std::size_t>(1, n / (8 * pool.size()));
+        }
+
+        // body(lo, hi) for pieces of [lo, hi) no larger than grain, in parallel
+        template <typename Body>
+        void
+        split(thread_pool &pool, std::size_t lo, std::size_t hi, std::size_t grain, const Body &body)
+        {
+            if (hi - lo <= grain)
+            {
+                TRACE_SCOPE("parallel leaf");
+                body(lo, hi);
+                return;
+            }
+            std::size_t mid = lo + (hi - lo) / 2;
+            pool.join([&] { split(pool, lo, mid, grain, body); }, [&] { split(pool, mid, hi, grain, body); });
+        }
+
+        // body(lo, hi) over [0, n), on the pool unless one piece covers everything
+        template <typename Body>
+        void
+        parallel_range(thread_pool &pool, std::size_t n, std::size_t grain, const Body &body)
+        {
+            if (n <= grain || pool.size() == 1)
+            {
+                if (n > 0)
+                {
+                    body(0, n);
+                }
+                return;
+            }
+            pool.run([&] { split(pool, 0, n, grain, body); });
+        }
+
+        // the result of splitting [lo, hi) like split(), each piece mapped by leaf and the results combined in order
+        template <typename T, typename Leaf, typename Combine>
+        T
+        split_reduce(thread_pool &pool, std::size_t lo, std::size_t hi, std::size_t grain, const Leaf &leaf,
+                     const Combine &combine)
+        {
+            if (hi - lo <= grain)
+            {
+                TRACE_SCOPE("parallel leaf");
+                return leaf(lo, hi);
+            }
+            std::size_t      mid = lo + (hi - lo) / 2;
+            std::optional<T> left, right;
+            pool.join([&] { left.emplace(split_reduce<T>(pool, lo, mid, grain, leaf, combine)); },
+                      [&] { right.emplace(split_reduce<T>(pool, mid, hi, grain, leaf, combine)); });
+            return combine(std::move(*left), std::move(*right));
+        }
+
+        // [first, last) cut into pieces of `grain` elements by one walk: chunks[i], chunks[i + 1] bound piece i
+        template <typename Iter>
+        std::vector<Iter>
+        chunks(Iter first, Iter last, std::size_t grain)
+        {
+            std::vector<Iter> bounds{first};
+            while (first != last)
+            {
+                for (std::size_t k = 0; k < grain && first != last; k++)
+                {
+                    ++first;
+                }
+                bounds.push_back(first);
+            }
+            return bounds;
+        }
+
+        // where the output of each of `pieces` pieces of chunks() starts: every one `grain` after the previous
+        template <typename Out>
+        std::vector<Out>
+        output_chunks(Out d_first, std::size_t pieces, std::size_t grain)
+        {
+            std::vector<Out> starts{d_first};
+            while (starts.size() < pieces)
+            {
+                for (std::size_t k = 0; k < grain; k++)
+                {
+                    ++d_first;
+                }
+                starts.push_back(d_first);
+            }
+            return starts;
+        }
+
+    } // namespace detail
+
+    // for_each
+
+    template <typename Iter, typename F>
+    void
+    for_each_impl(thread_pool &pool, Iter first, Iter last, const F &f, std::size_t grain, std::true_type)
+    {
+        auto n = static_cast<std::size_t>(last - first);
+        detail::parallel_range(pool, n, detail::auto_grain(pool, n, grain), [&](std::size_t lo, std::size_t hi) {
+            std::for_each(first + lo, first + hi, f);
+        });
+    }
+
+    template <typename Iter, typename F>
+    void
+    for_each_impl(thread_pool &pool, Iter first, Iter last, const F &f, std::size_t grain, std::false_type)
+    {
+        auto bounds = detail::chunks(first, last, grain ? grain : detail::chunked_grain);
+        detail::parallel_range(pool, bounds.size() - 1, 1, [&](std::size_t lo, std::size_t hi) {
+            std::for_each(bounds[lo], bounds[hi], f);
+        });
+    }
+
+    template <typename Iter, typename F>
+    void
+    for_each(thread_pool &pool, Iter first, Iter last, F f, std::size_t grain = 0)
+    {
+        if constexpr (!std::forward_iterator<Iter>)
+        {
+            std::for_each(first, last, f);
+        }
+        else
+        {
+            for_each_impl(pool, first, last, f, grain, random_access_tag<Iter>());
+        }
+    }
+
+    template <std::input_iterator Iter, typename F>
+    void
+    for_each(Iter first, Iter last, F f, std::size_t grain = 0)
+    {
+        for_each(default_pool(), first, last, std::move(f), grain);
+    }
+
+    // transform (in parallel when both ends are at least forward iterators, i.e. can be read and written in several
+    // places at once; otherwise the serial std::transform)
+
+    template <typename Iter, typename Out, typename F>
+    Out
+    transform_impl(thread_pool &pool, Iter first, Iter last, Out d_first, const F &op, std::size_t grain,
+                   std::true_type)
+    {
+        auto n = static_cast<std::size_t>(last - first);
+        detail::parallel_range(pool, n, detail::auto_grain(pool, n, grain), [&](std::size_t lo, std::size_t hi) {
+            std::transform(first + lo, first + hi, d_first + lo, op);
+        });
+        return d_first + static_cast<std::iter_difference_t<Out>>(n);
+    }
+
+    template <typename Iter, typename Out, typename F>
+    Out
+    transform_impl(thread_pool &pool, Iter first, Iter last, Out d_first, const F &op, std::size_t grain,
+                   std::false_type)
+    {
+        grain              = grain ? grain : detail::chunked_grain;
+        auto        bounds = detail::chunks(first, last, grain);
+        std::size_t pieces = bounds.size() - 1;
+        if (pieces == 0)
+        {
+            return d_first;
+        }
+        auto out = detail::output_chunks(d_first, pieces, grain);
+        detail::parallel_range(pool, pieces, 1, [&](std::size_t lo, std::size_t hi) {
+            for (std::size_t i = lo; i < hi; i++)
+            {
+                std::transform(bounds[i], bounds[i + 1], out[i], op);
+            }
+        });
+        return std::next(out.back(), std::distance(bounds[pieces - 1], last)); // the last piece may be short
+    }
+
+    template <typename Iter, typename Out, typename F>
+    Out
+    transform(thread_pool &pool, Iter first, Iter last, Out d_first, F op, std::size_t grain = 0)
+    {
+        if constexpr (!std::forward_iterator<Iter> || !std::forward_iterator<Out>)
+        {
+            return std::transform(first, last, d_first, op);
+        }
+        else
+        {
+            return transform_impl(pool, first, last, d_first, op, grain, random_access_tag2<Iter, Out>());
+        }
+    }
+
+    template <std::input_iterator Iter, typename Out, typename F>
+    Out
+    transform(Iter first, Iter last, Out d_first, F op, std::size_t grain = 0)
+    {
+        return transform(default_pool(), first, last, d_first, std::move(op), grain);
+    }
+
+    // transform_reduce: reduce(init, transform(x0), transform(x1), ...) in any grouping
+
+    template <typename Iter, typename T, typename Reduce, typename Transform>
+    T
+    transform_reduce_impl(thread_pool &pool, Iter first, Iter last, T init, const Reduce &reduce,
+                          const Transform &transform, std::size_t grain, std::true_type)
+    {
+        auto n = static_cast<std::size_t>(last - first);
+        if (n == 0)
+        {
+            return init;
+        }
+        grain     = detail::auto_grain(pool, n, grain);
+        auto leaf = [&](std::size_t lo, std::size_t hi) {
+            T acc = transform(first[lo]);
+            for (std::size_t i = lo + 1; i < hi; i++)
+            {
+                acc = reduce(std::move(acc), transform(first[i]));
+            }
+            return acc;
+        };
+        std::optional<T> total;
+        if (n <= grain || pool.size() == 1)
+        {
+            total.emplace(leaf(0, n));
+        }
+        else
+        {
+            pool.run([&] { total.emplace(detail::split_reduce<T>(pool, 0, n, grain, leaf, reduce)); });
+        }
+        return reduce(std::move(init), std::move(*total));
+    }
+
+    template <typename Iter, typename T, typename Reduce, typename Transform>
+    T
+    transform_reduce_impl(thread_pool &pool, Iter first, Iter last, T init, const Reduce &reduce,
+                          const Transform &transform, std::size_t grain, std::false_type)
+    {
+        auto bounds = detail::chunks(first, last, grain ? grain : detail::chunked_grain);
+        if (bounds.size() == 1)
+        {
+            return init;
+        }
+        auto leaf = [&](std::size_t lo, std::size_t hi) {
+            Iter it  = bounds[lo];
+            T    acc = transform(*it);
+            for (++it; it != bounds[hi]; ++it)
+            {
+                acc = reduce(std::move(acc), transform(*it));
+            }
+            return acc;
+        };
+        std::optional<T> total;
+        if (pool.size() == 1)
+        {
+            total.emplace(leaf(0, bounds.size() - 1));
+        }
+        else
+        {
+            pool.run([&] { total.emplace(detail::split_reduce<T>(pool, 0, bounds.size() - 1, 1, leaf, reduce)); });
+        }
+        return reduce(std::move(init), std::move(*total));
+    }
+
+    template <typename Iter, typename T, typename Reduce, typename Transform>
+    T
+    transform_reduce(thread_pool &pool, Iter first, Iter last, T init, Reduce reduce, Transform transform,
+                     std::size_t grain = 0)
+    {
+        if constexpr (!std::forward_iterator<Iter>)
+        {
+            return std::transform_reduce(first, last, std::move(init), reduce, transform);
+        }
+        else
+        {
+            return transform_reduce_impl(pool, first, last, std::move(init), reduce, transform, grain,
+                                         random_access_tag<Iter>());
+        }
+    }
+
+    template <std::input_iterator Iter, typename T, typename Reduce, typename Transform>
+    T
+    transform_reduce(Iter first, Iter last, T init, Reduce reduce, Transform transform, std::size_t grain = 0)
+    {
+        return transform_reduce(default_pool(), first, last, std::move(init), std::move(reduce), std::move(transform),
+                                grain);
+    }
+
+    // inclusive_scan: two passes over pieces of `grain` elements. The first reduces every piece; a serial scan of
+    // those sums gives every piece its offset; the second scans every piece from its offset into the output.
+
+    namespace detail
+    {
+        // bounds/out: piece i is [bounds[i], bounds[i + 1]) -> out[i]
+        template <typename Iter, typename Out, typename Op>
+        void
+        scan_pieces(thread_pool &pool, const std::vector<Iter> &bounds, const std::vector<Out> &out, const Op &op)
+        {
+            using T            = std::iter_value_t<Iter>;
+            std::size_t pieces = bounds.size() - 1;
+
+            std::vector<std::optional<T>> sums(pieces);
+            parallel_range(pool, pieces, 1, [&](std::size_t lo, std::size_t hi) {
+                for (std::size_t i = lo; i < hi; i++)
+                {
+                    Iter it  = bounds[i];
+                    T    acc = *it;
+                    for (++it; it != bounds[i + 1]; ++it)
+                    {
+                        acc = op(std::move(acc), *it);
+                    }
+                    sums[i].emplace(std::move(acc));
+                }
+            });
+            // sums[i] becomes the total of pieces 0..i, the offset of piece i + 1
+            for (std::size_t i = 1; i + 1 < pieces; i++)
+            {
+                sums[i].emplace(op(*sums[i - 1], std::move(*sums[i])));
+            }
+            parallel_range(pool, pieces, 1, [&](std::size_t lo, std::size_t hi) {
+                for (std::size_t i = lo; i < hi; i++)
+                {
+                    if (i == 0)
+                    {
+                        std::inclusive_scan(bounds[0], bounds[1], out[0], op);
+                    }
+                    else
+                    {
+                        std::inclusive_scan(bounds[i], bounds[i + 1], out[i], op, *sums[i - 1]);
+                    }
+                }
+            });
+        }
+
+    } // namespace detail
+
+    template <typename Iter, typename Out, typename Op>
+    Out
+    inclusive_scan_impl(thread_pool &pool, Iter first, Iter last, Out d_first, const Op &op, std::size_t grain,
+                        std::true_type)
+    {
+        auto n = static_cast<std::size_t>(last - first);
+        grain  = detail::auto_grain(pool, n, grain);
+        if (n <= grain || pool.size() == 1)
+        {
+            return std::inclusive_scan(first, last, d_first, op);
+        }
+        std::vector<Iter> bounds;
+        std::vector<Out>  out;
+        for (std::size_t i = 0; i < n; i += grain)
+        {
+            bounds.push_back(first + static_cast<std::iter_difference_t<Iter>>(i));
+            out.push_back(d_first + static_cast<std::iter_difference_t<Out>>(i));
+        }
+        bounds.push_back(last);
+        detail::scan_pieces(pool, bounds, out, op);
+        return d_first + static_cast<std::iter_difference_t<Out>>(n);
+    }
+
+    template <typename Iter, typename Out, typename Op>
+    Out
+    inclusive_scan_impl(thread_pool &pool, Iter first, Iter last, Out d_first, const Op &op, std::size_t grain,
+                        std::false_type)
+    {
+        grain       = grain ? grain : detail::chunked_grain;
+        auto bounds = detail::chunks(first, last, grain);
+        if (bounds.size() == 1)
+        {
+            return d_first;
+        }
+        auto out = detail::output_chunks(d_first, bounds.size() - 1, grain);
+        detail::scan_pieces(pool, bounds, out, op);
+        return std::next(out.back(), std::distance(bounds[bounds.size() - 2], last));
+    }
+
+    template <typename Iter, typename Out, typename Op = std::plus<>>
+    Out
+    inclusive_scan(thread_pool &pool, Iter first, Iter last, Out d_first, Op op = {}, std::size_t grain = 0)
+    {
+        if constexpr (!std::forward_iterator<Iter> || !std::forward_iterator<Out>)
+        {
+            return std::inclusive_scan(first, last, d_first, op); // single-pass input or output, as for transform
+        }
+        else
+        {
+            return inclusive_scan_impl(pool, first, last, d_first, op, grain, random_access_tag2<Iter, Out>());
+        }
+    }
+
+    template <std::input_iterator Iter, typename Out, typename Op = std::plus<>>
+    Out
+    inclusive_scan(Iter first, Iter last, Out d_first, Op op = {}, std::size_t grain = 0)
+    {
+        return inclusive_scan(default_pool(), first, last, d_first, std::move(op), grain);
+    }
+
+} // namespace parallel
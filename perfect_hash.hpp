@@ -0,0 +1,275 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace perfect_hash
+{
+    // Value-keyed counterpart of variable templates like is_void_v<T>: a map whose table is computed by the compiler.
+    //
+    //   constexpr auto commands = perfect_hash::make_map<std::string_view, int>({{"add", 1}, {"sub", 2}});
+    //   commands.find("sub")    // const int *, nullptr if the key is missing
+    //
+    // Hash and displace (CHD): the key is hashed once to h, and h picks one of `slots` buckets. The buckets are placed
+    // largest first, and each gets the first seed d for which remix(h, d) sends all its keys to free slots. A lookup
+    // is therefore one hash, one seed load, one remix, one index load and one key comparison. There are no probes and
+    // no collisions. The map is a literal type, so a constexpr map lives in .rodata and needs no startup code.
+    // Duplicate keys are a compile error.
+
+    // hasher<Key>::hash(key): a constexpr 64-bit hash. Specialize it for other key types.
+    template <typename Key, typename = void>
+    struct hasher;
+
+    namespace detail
+    {
+        constexpr std::uint64_t
+        mix(std::uint64_t x)
+        {
+            // splitmix64 finalizer
+            x ^= x >> 30;
+            x *= 0xbf58476d1ce4e5b9;
+            x ^= x >> 27;
+            x *= 0x94d049bb133111eb;
+            x ^= x >> 31;
+            return x;
+        }
+
+    } // namespace detail
+
+    template <>
+    struct hasher<std::string_view>
+    {
+        static constexpr std::uint64_t
+        hash(std::string_view key)
+        {
+            // 8 bytes per step, and a tail of 0..7 bytes read as at most two overlapping loads, so that short keys
+            // take no byte loop (the same trick as wyhash). load() assembles little-endian words from bytes, which
+            // works in constant evaluation and compiles to a plain load.
+            std::uint64_t     h = 0xcbf29ce484222325 ^ key.size();
+            std::size_t       i = 0;
+            const std::size_t n = key.size();
+            for (; i + 8 <= n; i += 8)
+            {
+                h = (h ^ load<8>(key, i)) * 0x9e3779b97f4a7c15;
+                h ^= h >> 29;
+            }
+
+            std::size_t   rest = n - i;
+            std::uint64_t tail = 0;
+            if (rest >= 4)
+            {
+                tail = load<4>(key, i) << 32 | load<4>(key, n - 4);
+            }
+            else if (rest > 0)
+            {
+                tail = std::uint64_t(byte(key, i)) << 16 | std::uint64_t(byte(key, i + rest / 2)) << 8 |
+                       byte(key, n - 1);
+            }
+            return detail::mix(h ^ tail);
+        }
+
+      private:
+        static constexpr unsigned char
+        byte(std::string_view key, std::size_t at)
+        {
+            return static_cast<unsigned char>(key[at]);
+        }
+
+        template <std::size_t Bytes>
+        static constexpr std::uint64_t
+        load(std::string_view key, std::size_t at)
+        {
+            std::uint64_t w = 0;
+            for (std::size_t b = 0; b < Bytes; b++)
+            {
+                w |= std::uint64_t(byte(key, at + b)) << (8 * b);
+            }
+            return w;
+        }
+    };
+
+    template <typename Key>
+    struct hasher<Key, std::enable_if_t<std::is_integral_v<Key> || std::is_enum_v<Key>>>
+    {
+        static constexpr std::uint64_t
+        hash(Key key)
+        {
+            return detail::mix(static_cast<std::uint64_t>(key));
+        }
+    };
+
+    template <typename Key, typename Value, std::size_t N, typename Hash = hasher<Key>>
+    class map
+    {
+      public:
+        using value_type = std::pair<Key, Value>;
+
+        // power of two, so that reducing a hash is a mask
+        static constexpr std::size_t slots = std::bit_ceil(N == 0 ? std::size_t(1) : N);
+
+        constexpr explicit map(const value_type (&entries)[N])
+        {
+            for (std::size_t i = 0; i < N; i++)
+            {
+                entries_[i] = entries[i];
+            }
+            build();
+        }
+
+        constexpr const Value *
+        find(const Key &key) const
+        {
+            std::uint64_t h = Hash::hash(key);
+            std::size_t   i = index_[slot(h, seeds_[h & (slots - 1)])];
+            return i < N && entries_[i].first == key ? &entries_[i].second : nullptr;
+        }
+
+        constexpr bool
+        contains(const Key &key) const
+        {
+            return find(key) != nullptr;
+        }
+
+        constexpr const Value &
+        at(const Key &key) const
+        {
+            const Value *v = find(key);
+            if (!v)
+            {
+                throw std::out_of_range("perfect_hash::map::at: no such key");
+            }
+            return *v;
+        }
+
+        static constexpr std::size_t
+        size()
+        {
+            return N;
+        }
+
+        // the entries in the order they were given
+        constexpr const value_type *
+        begin() const
+        {
+            return entries_.data();
+        }
+
+        constexpr const value_type *
+        end() const
+        {
+            return entries_.data() + N;
+        }
+
+      private:
+        // the bucket is the low bits of h; a seed takes the high bits of the remixed hash
+        static constexpr std::size_t
+        slot(std::uint64_t h, std::uint32_t seed)
+        {
+            return static_cast<std::size_t>(detail::mix(h ^ (seed * 0x9e3779b97f4a7c15)) >> 32) & (slots - 1);
+        }
+
+        constexpr void
+        build()
+        {
+            // entries grouped by bucket (counting sort), and the buckets ordered by size, largest first
+            std::array<std::size_t, slots + 1> first{}; // bucket b is by_bucket[first[b], first[b + 1])
+            std::array<std::uint64_t, N>       hash{};
+            std::array<std::size_t, N>         bucket{};
+            for (std::size_t i = 0; i < N; i++)
+            {
+                hash[i]   = Hash::hash(entries_[i].first);
+                bucket[i] = hash[i] & (slots - 1);
+                first[bucket[i] + 1]++;
+            }
+            std::size_t largest = 0;
+            for (std::size_t b = 0; b < slots; b++)
+            {
+                largest = std::max(largest, first[b + 1]);
+                first[b + 1] += first[b];
+            }
+            std::array<std::size_t, N>     by_bucket{};
+            std::array<std::size_t, slots> fill{};
+            for (std::size_t i = 0; i < N; i++)
+            {
+                by_bucket[first[bucket[i]] + fill[bucket[i]]++] = i;
+            }
+
+            for (std::size_t s = 0; s < slots; s++)
+            {
+                index_[s] = static_cast<std::uint32_t>(N);
+            }
+            // equal keys share a bucket and collide for every seed, so they are checked for here
+            std::array<std::size_t, N> taken{};
+            for (std::size_t size = largest; size > 0; size--)
+            {
+                for (std::size_t b = 0; b < slots; b++)
+                {
+                    if (fill[b] == size)
+                    {
+                        const std::size_t *members = by_bucket.data() + first[b];
+                        for (std::size_t m = 0; m < size; m++)
+                        {
+                            for (std::size_t k = 0; k < m; k++)
+                            {
+                                if (entries_[members[m]].first == entries_[members[k]].first)
+                                {
+                                    throw std::invalid_argument("perfect_hash::map: duplicate key");
+                                }
+                            }
+                        }
+                        seeds_[b] = place(hash, members, size, taken.data());
+                    }
+                }
+            }
+        }
+
+        // first seed that puts all `count` members into distinct free slots; claims those slots
+        constexpr std::uint32_t
+        place(const std::array<std::uint64_t, N> &hash, const std::size_t *members, std::size_t count,
+              std::size_t *taken)
+        {
+            for (std::uint32_t seed = 1; seed != 0; seed++)
+            {
+                bool fits = true;
+                for (std::size_t m = 0; m < count && fits; m++)
+                {
+                    taken[m] = slot(hash[members[m]], seed);
+                    fits     = index_[taken[m]] == N;
+                    for (std::size_t k = 0; k < m && fits; k++)
+                    {
+                        fits = taken[k] != taken[m];
+                    }
+                }
+                if (fits)
+                {
+                    for (std::size_t m = 0; m < count; m++)
+                    {
+                        index_[taken[m]] = static_cast<std::uint32_t>(members[m]);
+                    }
+                    return seed;
+                }
+            }
+            throw std::logic_error("perfect_hash::map: no seed found");
+        }
+
+        std::array<value_type, N>        entries_{};
+        std::array<std::uint32_t, slots> seeds_{};
+        std::array<std::uint32_t, slots> index_{}; // entry in each slot, N if it is free
+    };
+
+    // make_map<Key, Value>({{k, v}, ...}): like std::to_array, N is deduced from the braced list.
+    template <typename Key, typename Value, typename Hash = hasher<Key>, std::size_t N>
+    constexpr map<Key, Value, N, Hash>
+    make_map(const std::pair<Key, Value> (&entries)[N])
+    {
+        return map<Key, Value, N, Hash>(entries);
+    }
+
+} // namespace perfect_hash
@@ -0,0 +1,354 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace persistent
+{
+    // An on-disk format for myvec<T>: a fixed header, then the elements exactly as they are laid out in memory.
+    // Loading maps the file and hands out a read-only span into the mapping: no parsing, no copy, and pages are
+    // read from disk (or found in the page cache) only when touched.
+    //
+    //   save(path, v)          writes v (any contiguous range of T)
+    //   mapped<T> m(path)      maps a file written by save<T>; m.data() is a std::span<const T>
+    //   read<T>(path)          the same file copied into a myvec<T> (when the elements must be modifiable)
+    //
+    // The header records the format version, T (as a hash of its typeid name, plus the name for error messages),
+    // sizeof(T), alignof(T), the element count and the byte order; a file that doesn't match T on this machine is
+    // rejected with persistent::format_error. Elements start at byte 128, aligned for any T.
+    //
+    // Only types whose bytes mean the same thing in another process can be stored: is_persistable<T>, built like
+    // how_to_partially_specialize_a_function::is_pointer_impl (a class template, partially specialized). Pointers,
+    // member pointers and references are rejected; arrays and std::array follow their element; arithmetic and enum
+    // types are accepted. A class type must be trivially copyable and opt in, since its members can't be inspected:
+    //
+    //     struct point
+    //     {
+    //         double x, y;
+    //         using persistable = std::true_type;
+    //     };
+
+    template <typename T, typename = void>
+    struct is_persistable_impl
+    {
+        static constexpr bool value = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+    };
+
+    // opted-in class types
+    template <typename T>
+    struct is_persistable_impl<T, std::enable_if_t<std::is_class_v<T>, std::void_t<typename T::persistable>>>
+    {
+        static constexpr bool value = T::persistable::value && std::is_trivially_copyable_v<T>;
+    };
+
+    template <typename T>
+    struct is_persistable_impl<T *>
+    {
+        static constexpr bool value = false;
+    };
+
+    template <typename T, std::size_t N>
+    struct is_persistable_impl<T[N]> : is_persistable_impl<T>
+    {
+    };
+
+    template <typename T, std::size_t N>
+    struct is_persistable_impl<std::array<T, N>> : is_persistable_impl<T>
+    {
+    };
+
+    template <typename T>
+    inline constexpr bool is_persistable = is_persistable_impl<std::remove_cv_t<T>>::value;
+
+    class format_error : public std::runtime_error
+    {
+      public:
+        using std::runtime_error::runtime_error;
+    };
+
+    namespace detail
+    {
+        inline constexpr std::array<char, 8> magic   = {'m', 'y', 'v', 'e', 'c', '\0', '\r', '\n'};
+        inline constexpr std::uint32_t       version = 1;
+        inline constexpr std::size_t         offset  = 128; // of the elements: the header, padded
+
+        struct header
+        {
+            std::array<char, 8> magic;
+            std::uint32_t       version;
+            std::uint32_t       little_endian;
+            std::uint64_t       type_hash;
+            char                type_name[64]; // truncated, for error messages only
+            std::uint64_t       element_size;
+            std::uint64_t       element_align;
+            std::uint64_t       count;
+            std::uint64_t       data_offset;
+        };
+
+        static_assert(sizeof(header) <= offset);
+
+        // FNV-1a
+        inline std::uint64_t
+        hash(const char *s)
+        {
+            std::uint64_t h = 14695981039346656037u;
+            for (; *s; s++)
+            {
+                h = (h ^ static_cast<unsigned char>(*s)) * 1099511628211u;
+            }
+            return h;
+        }
+
+        template <typename T>
+        header
+        make_header(std::size_t count)
+        {
+            header h{};
+            h.magic         = magic;
+            h.version       = version;
+            h.little_endian = std::endian::native == std::endian::little;
+            h.type_hash     = hash(typeid(T).name());
+            std::strncpy(h.type_name, typeid(T).name(), sizeof h.type_name - 1);
+            h.element_size  = sizeof(T);
+            h.element_align = alignof(T);
+            h.count         = count;
+            h.data_offset   = offset;
+            return h;
+        }
+
+        // throws unless h describes `bytes` bytes of T written on a machine like this one
+        template <typename T>
+        void
+        check(const header &h, std::size_t bytes, const std::string &path)
+        {
+            auto fail = [&](const std::string &what) {
+                throw format_error("persistent: " + path + ": " + what);
+            };
+            if (bytes < sizeof(header) || h.magic != magic)
+            {
+                fail("not a myvec file");
+            }
+            if (h.version != version)
+            {
+                fail("format version " + std::to_string(h.version) + ", expected " + std::to_string(version));
+            }
+            header expected = make_header<T>(0);
+            if (h.little_endian != expected.little_endian)
+            {
+                fail("written with the other byte order");
+            }
+            if (h.type_hash != expected.type_hash || h.element_size != sizeof(T) || h.element_align != alignof(T))
+            {
+                fail(std::string("holds ") + std::string(h.type_name, strnlen(h.type_name, sizeof h.type_name)) +
+                     ", expected " + expected.type_name);
+            }
+            if (h.data_offset % alignof(T) != 0 || h.data_offset > bytes ||
+                h.count > (bytes - h.data_offset) / sizeof(T))
+            {
+                fail("truncated");
+            }
+        }
+
+        [[noreturn]] inline void
+        throw_errno(const std::string &what, const std::string &path)
+        {
+            throw std::system_error(errno, std::generic_category(), "persistent: " + what + " " + path);
+        }
+
+    } // namespace detail
+
+    template <typename T>
+    void
+    save(const std::string &path, std::span<const T> elements)
+    {
+        static_assert(is_persistable<T>, "persistent::save: T must be persistable (see is_persistable_impl)");
+
+        detail::header h = detail::make_header<T>(elements.size());
+        char           block[detail::offset]{};
+        std::memcpy(block, &h, sizeof h);
+
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(block, sizeof block);
+        out.write(reinterpret_cast<const char *>(elements.data()),
+                  static_cast<std::streamsize>(elements.size_bytes()));
+        out.close();
+        if (!out)
+        {
+            throw std::runtime_error("persistent: cannot write " + path);
+        }
+    }
+
+    // e.g. save(path, v) for a myvec<T, Policy> v
+    template <typename T, typename A>
+    void
+    save(const std::string &path, const std::vector<T, A> &v)
+    {
+        save(path, std::span<const T>(v));
+    }
+
+    // A read-only mapping of a file written by save<T>. Move-only; the span dies with it.
+    template <typename T>
+    class mapped
+    {
+        static_assert(is_persistable<T>, "persistent::mapped: T must be persistable (see is_persistable_impl)");
+
+      public:
+        explicit mapped(const std::string &path)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)
+            {
+                detail::throw_errno("cannot open", path);
+            }
+            struct stat st;
+            if (::fstat(fd, &st) != 0)
+            {
+                ::close(fd);
+                detail::throw_errno("cannot stat", path);
+            }
+            bytes_ = static_cast<std::size_t>(st.st_size);
+            if (bytes_ < sizeof(detail::header))
+            {
+                ::close(fd);
+                throw format_error("persistent: " + path + ": not a myvec file");
+            }
+            base_ = ::mmap(nullptr, bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd); // the mapping keeps the file
+            if (base_ == MAP_FAILED)
+            {
+                detail::throw_errno("cannot map", path);
+            }
+
+            detail::header h;
+            std::memcpy(&h, base_, sizeof h);
+            try
+            {
+                detail::check<T>(h, bytes_, path);
+            }
+            catch (...)
+            {
+                ::munmap(base_, bytes_);
+                throw;
+            }
+            elements_ = {reinterpret_cast<const T *>(static_cast<const char *>(base_) + h.data_offset),
+                         static_cast<std::size_t>(h.count)};
+        }
+
+        mapped(mapped &&other) noexcept
+            : base_(std::exchange(other.base_, nullptr)), bytes_(std::exchange(other.bytes_, 0)),
+              elements_(std::exchange(other.elements_, {}))
+        {
+        }
+
+        mapped &
+        operator=(mapped &&other) noexcept
+        {
+            if (this != &other)
+            {
+                unmap();
+                base_     = std::exchange(other.base_, nullptr);
+                bytes_    = std::exchange(other.bytes_, 0);
+                elements_ = std::exchange(other.elements_, {});
+            }
+            return *this;
+        }
+
+        ~mapped()
+        {
+            unmap();
+        }
+
+        std::span<const T>
+        data() const noexcept
+        {
+            return elements_;
+        }
+
+        std::size_t
+        size() const noexcept
+        {
+            return elements_.size();
+        }
+
+        const T &
+        operator[](std::size_t i) const noexcept
+        {
+            return elements_[i];
+        }
+
+        auto
+        begin() const noexcept
+        {
+            return elements_.begin();
+        }
+
+        auto
+        end() const noexcept
+        {
+            return elements_.end();
+        }
+
+      private:
+        void
+        unmap() noexcept
+        {
+            if (base_)
+            {
+                ::munmap(base_, bytes_);
+            }
+        }
+
+        void              *base_  = nullptr;
+        std::size_t        bytes_ = 0;
+        std::span<const T> elements_;
+    };
+
+    // the copying loader: one read of the whole file into a new vector
+    template <typename T>
+    std::vector<T>
+    read(const std::string &path)
+    {
+        static_assert(is_persistable<T>, "persistent::read: T must be persistable (see is_persistable_impl)");
+
+        std::ifstream in(path, std::ios::binary);
+        if (!in)
+        {
+            detail::throw_errno("cannot open", path);
+        }
+        in.seekg(0, std::ios::end);
+        auto bytes = static_cast<std::size_t>(in.tellg());
+        in.seekg(0);
+
+        detail::header h{};
+        in.read(reinterpret_cast<char *>(&h), sizeof h);
+        detail::check<T>(h, bytes, path);
+
+        std::vector<T> v(static_cast<std::size_t>(h.count));
+        in.seekg(static_cast<std::streamoff>(h.data_offset));
+        in.read(reinterpret_cast<char *>(v.data()), static_cast<std::streamsize>(v.size() * sizeof(T)));
+        if (!in)
+        {
+            throw format_error("persistent: " + path + ": truncated");
+        }
+        return v;
+    }
+
+} // namespace persistent
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "trace.hpp" // TRACE_SCOPE around every section
+
+namespace sections
+{
+    // A demo section of main(): `run` prints what the section demonstrates. `name` is the title printed as
+    // "=== name" and `ns` is the namespace it demonstrates. Patterns on the command line match either of them.
+    struct section
+    {
+        std::string_view name;
+        std::string_view ns;
+        void (*run)();
+    };
+
+    class registry
+    {
+      public:
+        void
+        add(std::string_view name, std::string_view ns, void (*run)())
+        {
+            sections_.push_back({name, ns, run});
+        }
+
+        const std::vector<section> &
+        all() const
+        {
+            return sections_;
+        }
+
+      private:
+        std::vector<section> sections_;
+    };
+
+    // Shell-style glob: `*` matches any run of characters and `?` matches exactly one.
+    inline bool
+    glob_match(std::string_view pattern, std::string_view text)
+    {
+        std::size_t p = 0, t = 0;
+        std::size_t star = std::string_view::npos, resume = 0;
+        while (t < text.size())
+        {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t]))
+            {
+                p++;
+                t++;
+            }
+            else if (p < pattern.size() && pattern[p] == '*')
+            {
+                star   = p++;
+                resume = t;
+            }
+            else if (star != std::string_view::npos)
+            {
+                p = star + 1;
+                t = ++resume;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        while (p < pattern.size() && pattern[p] == '*')
+        {
+            p++;
+        }
+        return p == pattern.size();
+    }
+
+    // Output sink for std::cout. It writes into the stdout FILE buffer, so output stays in order with puts()
+    // from the demos. sync() does nothing, so `std::endl` no longer costs a flush (and a write(2)) per line. The
+    // buffer is flushed when it is full and once at the end.
+    class stdout_sink : public std::streambuf
+    {
+      protected:
+        int_type
+        overflow(int_type c) override
+        {
+            if (traits_type::eq_int_type(c, traits_type::eof()))
+            {
+                return traits_type::not_eof(c);
+            }
+            return std::putc(traits_type::to_char_type(c), stdout) == EOF ? traits_type::eof() : c;
+        }
+
+        std::streamsize
+        xsputn(const char *s, std::streamsize n) override
+        {
+            return static_cast<std::streamsize>(std::fwrite(s, 1, static_cast<std::size_t>(n), stdout));
+        }
+
+        int
+        sync() override
+        {
+            return 0;
+        }
+    };
+
+    // Installs stdout_sink on std::cout with a fully buffered stdout, even on a terminal. The destructor restores
+    // std::cout and flushes. Must be created before anything is written to stdout.
+    class buffered_stdout
+    {
+      public:
+        buffered_stdout()
+        {
+            static char buffer[1 << 16]; // static: stdout keeps using it after we are gone
+            std::setvbuf(stdout, buffer, _IOFBF, sizeof buffer);
+            previous_ = std::cout.rdbuf(&sink_);
+        }
+
+        buffered_stdout(const buffered_stdout &) = delete;
+        buffered_stdout &
+        operator=(const buffered_stdout &) = delete;
+
+        ~buffered_stdout()
+        {
+            std::cout.rdbuf(previous_);
+            std::fflush(stdout);
+        }
+
+      private:
+        stdout_sink     sink_;
+        std::streambuf *previous_;
+    };
+
+    struct timing
+    {
+        const section *s;
+        double         ns;
+    };
+
+    namespace detail
+    {
+        inline void
+        usage(const char *argv0)
+        {
+            std::fprintf(stderr,
+                         "usage: %s [--list] [--summary] [--json=FILE] [--trace=FILE] [PATTERN...]\n"
+                         "  PATTERN  glob (* and ?) matched against section titles and namespaces; default: all\n"
+                         "  --list     print the sections instead of running them\n"
+                         "  --summary  print a table with the time taken by each section\n"
+                         "  --json     write the times as JSON to FILE\n"
+                         "  --trace    write a Chrome/Perfetto trace to FILE (needs a build with TRACING=1)\n",
+                         argv0);
+        }
+
+        inline std::string
+        escape(std::string_view s)
+        {
+            std::string out;
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out += '\\';
+                }
+                out += c;
+            }
+            return out;
+        }
+
+        inline bool
+        selected(const section &s, const std::vector<std::string_view> &patterns)
+        {
+            if (patterns.empty())
+            {
+                return true;
+            }
+            for (std::string_view p : patterns)
+            {
+                if (glob_match(p, s.name) || glob_match(p, s.ns))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+    } // namespace detail
+
+    // Runs the sections selected on the command line, each under a "=== name" header, and returns the exit code
+    // for main(): 0, or 2 for a bad command line or patterns that select nothing.
+    inline int
+    run(const registry &r, int argc, char **argv)
+    {
+        std::vector<std::string_view> patterns;
+        bool                          list    = false;
+        bool                          summary = false;
+        std::string                   json_path;
+        std::string                   trace_path;
+
+        for (int i = 1; i < argc; i++)
+        {
+            std::string_view arg = argv[i];
+            if (arg == "--list")
+            {
+                list = true;
+            }
+            else if (arg == "--summary")
+            {
+                summary = true;
+            }
+            else if (arg.substr(0, 7) == "--json=" && arg.size() > 7)
+            {
+                json_path = arg.substr(7);
+            }
+            else if (arg.substr(0, 8) == "--trace=" && arg.size() > 8)
+            {
+                trace_path = arg.substr(8);
+            }
+            else if (arg.substr(0, 1) == "-")
+            {
+                detail::usage(argv[0]);
+                return arg == "--help" ? 0 : 2;
+            }
+            else
+            {
+                patterns.push_back(arg);
+            }
+        }
+
+        std::vector<const section *> chosen;
+        for (const section &s : r.all())
+        {
+            if (detail::selected(s, patterns))
+            {
+                chosen.push_back(&s);
+            }
+        }
+        if (chosen.empty())
+        {
+            std::fprintf(stderr, "%s: no section matches\n", argv[0]);
+            return 2;
+        }
+
+        if (list)
+        {
+            for (const section *s : chosen)
+            {
+                std::printf("%-56.*s %.*s\n", int(s->ns.size()), s->ns.data(), int(s->name.size()), s->name.data());
+            }
+            return 0;
+        }
+
+        std::vector<timing> timings;
+        {
+            buffered_stdout out;
+            for (const section *s : chosen)
+            {
+                std::cout << (timings.empty() ? "" : "\n") << "=== " << s->name << "\n\n";
+                auto start = std::chrono::steady_clock::now();
+                {
+                    TRACE_SCOPE(s->name);
+                    s->run();
+                }
+                auto stop = std::chrono::steady_clock::now();
+                timings.push_back({s, std::chrono::duration<double, std::nano>(stop - start).count()});
+            }
+        }
+
+        if (summary)
+        {
+            double total = 0;
+            std::printf("\n%-56s %12s %s\n", "section", "us", "title");
+            for (const timing &t : timings)
+            {
+                std::printf("%-56.*s %12.1f %.*s\n", int(t.s->ns.size()), t.s->ns.data(), t.ns / 1e3,
+                            int(t.s->name.size()), t.s->name.data());
+                total += t.ns;
+            }
+            std::printf("%-56s %12.1f\n", "total", total / 1e3);
+        }
+
+        if (!json_path.empty())
+        {
+            std::ofstream json(json_path);
+            json << "{\n  \"unit\": \"ns\",\n  \"sections\": [\n";
+            for (std::size_t i = 0; i < timings.size(); i++)
+            {
+                const timing &t = timings[i];
+                json << "    {\"name\": \"" << detail::escape(t.s->name) << "\", \"namespace\": \""
+                     << detail::escape(t.s->ns) << "\", \"ns\": " << static_cast<long long>(t.ns) << "}"
+                     << (i + 1 < timings.size() ? ",\n" : "\n");
+            }
+            json << "  ]\n}\n";
+            if (!json)
+            {
+                std::fprintf(stderr, "%s: cannot write %s\n", argv[0], json_path.c_str());
+                return 2;
+            }
+        }
+
+        if (!trace_path.empty())
+        {
+            if (!tracing::enabled)
+            {
+                std::fprintf(stderr, "%s: built without TRACING=1, the trace is empty\n", argv[0]);
+            }
+            if (!tracing::write_chrome_json(trace_path))
+            {
+                std::fprintf(stderr, "%s: cannot write %s\n", argv[0], trace_path.c_str());
+                return 2;
+            }
+        }
+        return 0;
+    }
+
+} // namespace sections
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace good_tag_dispatch
+{
+    // Segmented iterators (Austern, "Segmented Iterators and Hierarchical Algorithms"): node-based containers like
+    // mylist and tree are sequences of contiguous chunks. An iterator that says
+    //
+    //     using supports_segments = std::true_type;
+    //
+    // next to `supports_plus` also provides
+    //
+    //     segment()            span from *this to the end of its segment
+    //     segment_until(last)  the same, but stopping at `last` if that comes first
+    //     same_segment(other)  whether `other` points into the same segment
+    //     next_segment()       first element of the following segment
+    //     local_advance(k)     k elements further inside the segment (may land on next_segment())
+    //
+    // and for_each/copy/fill/find below run a tight loop over every span instead of one `++` per element.
+    // Everything else goes through the plain std algorithms; tag dispatch picks the version, like advance_impl.
+
+    // std::false_type for iterators that don't mention it (raw pointers, std::vector<T>::iterator, ...)
+    template <typename Iter, typename = void>
+    struct supports_segments : std::false_type
+    {
+    };
+
+    template <typename Iter>
+    struct supports_segments<Iter, std::void_t<typename Iter::supports_segments>> : Iter::supports_segments
+    {
+    };
+
+    template <typename Iter>
+    using segments_tag = typename supports_segments<Iter>::type;
+
+    // for_each
+
+    template <typename Iter, typename F>
+    F
+    for_each_impl(Iter first, Iter last, F f, std::false_type)
+    {
+        return std::for_each(first, last, std::move(f));
+    }
+
+    template <typename Iter, typename F>
+    F
+    for_each_impl(Iter first, Iter last, F f, std::true_type)
+    {
+        while (first != last)
+        {
+            for (auto &x : first.segment_until(last))
+            {
+                f(x);
+            }
+            if (first.same_segment(last))
+            {
+                break;
+            }
+            first = first.next_segment();
+        }
+        return f;
+    }
+
+    template <typename Iter, typename F>
+    F
+    for_each(Iter first, Iter last, F f)
+    {
+        return for_each_impl(first, last, std::move(f), segments_tag<Iter>());
+    }
+
+    // fill
+
+    template <typename Iter, typename T>
+    void
+    fill_impl(Iter first, Iter last, const T &value, std::false_type)
+    {
+        std::fill(first, last, value);
+    }
+
+    template <typename Iter, typename T>
+    void
+    fill_impl(Iter first, Iter last, const T &value, std::true_type)
+    {
+        while (first != last)
+        {
+            auto seg = first.segment_until(last);
+            std::fill(seg.begin(), seg.end(), value);
+            if (first.same_segment(last))
+            {
+                break;
+            }
+            first = first.next_segment();
+        }
+    }
+
+    template <typename Iter, typename T>
+    void
+    fill(Iter first, Iter last, const T &value)
+    {
+        fill_impl(first, last, value, segments_tag<Iter>());
+    }
+
+    // find
+
+    template <typename Iter, typename T>
+    Iter
+    find_impl(Iter first, Iter last, const T &value, std::false_type)
+    {
+        return std::find(first, last, value);
+    }
+
+    template <typename Iter, typename T>
+    Iter
+    find_impl(Iter first, Iter last, const T &value, std::true_type)
+    {
+        while (first != last)
+        {
+            auto seg = first.segment_until(last);
+            auto hit = std::find(seg.begin(), seg.end(), value);
+            if (hit != seg.end())
+            {
+                return first.local_advance(static_cast<std::size_t>(hit - seg.begin()));
+            }
+            if (first.same_segment(last))
+            {
+                break;
+            }
+            first = first.next_segment();
+        }
+        return last;
+    }
+
+    template <typename Iter, typename T>
+    Iter
+    find(Iter first, Iter last, const T &value)
+    {
+        return find_impl(first, last, value, segments_tag<Iter>());
+    }
+
+    // copy: either side (or both) may be segmented
+
+    template <typename InIter, typename OutIter>
+    OutIter
+    copy_impl(InIter first, InIter last, OutIter d_first, std::false_type, std::false_type)
+    {
+        return std::copy(first, last, d_first);
+    }
+
+    // segmented input: one std::copy (a memmove for trivially copyable T into a pointer) per input segment
+    template <typename InIter, typename OutIter>
+    OutIter
+    copy_impl(InIter first, InIter last, OutIter d_first, std::true_type, std::false_type)
+    {
+        while (first != last)
+        {
+            auto seg = first.segment_until(last);
+            d_first  = std::copy(seg.begin(), seg.end(), d_first);
+            if (first.same_segment(last))
+            {
+                break;
+            }
+            first = first.next_segment();
+        }
+        return d_first;
+    }
+
+    // segmented output: fills the destination one segment at a time
+    // NOTE: like std::copy, the destination must already hold enough elements.
+    template <typename InIter, typename OutIter>
+    OutIter
+    copy_impl(InIter first, InIter last, OutIter d_first, std::false_type, std::true_type)
+    {
+        while (first != last)
+        {
+            auto        seg = d_first.segment();
+            std::size_t n   = 0;
+            for (; n < seg.size() && first != last; ++n, ++first)
+            {
+                seg[n] = *first;
+            }
+            d_first = d_first.local_advance(n);
+        }
+        return d_first;
+    }
+
+    // both segmented: copy the overlap of the current input and output segments at a time
+    template <typename InIter, typename OutIter>
+    OutIter
+    copy_impl(InIter first, InIter last, OutIter d_first, std::true_type, std::true_type)
+    {
+        while (first != last)
+        {
+            auto        in  = first.segment_until(last);
+            auto        out = d_first.segment();
+            std::size_t n   = std::min(in.size(), out.size());
+            std::copy_n(in.begin(), n, out.begin());
+            first   = first.local_advance(n);
+            d_first = d_first.local_advance(n);
+        }
+        return d_first;
+    }
+
+    template <typename InIter, typename OutIter>
+    OutIter
+    copy(InIter first, InIter last, OutIter d_first)
+    {
+        return copy_impl(first, last, d_first, segments_tag<InIter>(), segments_tag<OutIter>());
+    }
+
+} // namespace good_tag_dispatch
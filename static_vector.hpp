@@ -0,0 +1,728 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace class_templates
+{
+    // static_vector<T, N>: a vector with its capacity in the type, like std::array<T, N> (see puzzle_1) but with a
+    // variable length 0..N. The elements live inside the object, so it never touches the heap. Going past N throws
+    // std::length_error, where std::vector would reallocate.
+    //
+    // The storage is a std::array of uninitialized slots, and the special members are defaulted whenever T's are
+    // trivial: static_vector<T, N> is trivially copyable (memcpy-able, passable in registers when small) if T is.
+    //
+    // Iterators are contiguous and declare supports_plus, so good_tag_dispatch::advance uses `+`.
+
+    namespace detail
+    {
+        // one element's worth of uninitialized storage; its special members are trivial exactly when T's are
+        template <typename T>
+        union vector_slot
+        {
+            constexpr vector_slot() noexcept
+            {
+            }
+
+            vector_slot(const vector_slot &) = default;
+            vector_slot(vector_slot &&)      = default;
+            vector_slot &
+            operator=(const vector_slot &) = default;
+            vector_slot &
+            operator=(vector_slot &&) = default;
+
+            ~vector_slot()
+                requires std::is_trivially_destructible_v<T>
+            = default;
+
+            ~vector_slot()
+            {
+            }
+
+            T value;
+        };
+
+        // smallest unsigned type that holds 0..N
+        template <std::size_t N>
+        using vector_size_t =
+            std::conditional_t<N <= UINT8_MAX, std::uint8_t,
+                               std::conditional_t<N <= UINT16_MAX, std::uint16_t,
+                                                  std::conditional_t<N <= UINT32_MAX, std::uint32_t, std::size_t>>>;
+
+    } // namespace detail
+
+    template <typename T, std::size_t N>
+    class static_vector;
+
+    template <typename T, bool Const>
+    class static_vector_iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept  = std::contiguous_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<Const, const T *, T *>;
+        using reference         = std::conditional_t<Const, const T &, T &>;
+        using supports_plus     = std::true_type; // see good_tag_dispatch
+
+        static_vector_iterator() = default;
+
+        // iterator -> const_iterator
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        static_vector_iterator(const static_vector_iterator<T, false> &other) : p_(other.p_)
+        {
+        }
+
+        reference
+        operator*() const
+        {
+            return *p_;
+        }
+
+        pointer
+        operator->() const
+        {
+            return p_;
+        }
+
+        reference
+        operator[](difference_type n) const
+        {
+            return p_[n];
+        }
+
+        static_vector_iterator &
+        operator++()
+        {
+            ++p_;
+            return *this;
+        }
+
+        static_vector_iterator
+        operator++(int)
+        {
+            return static_vector_iterator(p_++);
+        }
+
+        static_vector_iterator &
+        operator--()
+        {
+            --p_;
+            return *this;
+        }
+
+        static_vector_iterator
+        operator--(int)
+        {
+            return static_vector_iterator(p_--);
+        }
+
+        static_vector_iterator &
+        operator+=(difference_type n)
+        {
+            p_ += n;
+            return *this;
+        }
+
+        static_vector_iterator &
+        operator-=(difference_type n)
+        {
+            p_ -= n;
+            return *this;
+        }
+
+        friend static_vector_iterator
+        operator+(static_vector_iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend static_vector_iterator
+        operator+(difference_type n, static_vector_iterator it)
+        {
+            return it += n;
+        }
+
+        friend static_vector_iterator
+        operator-(static_vector_iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type
+        operator-(const static_vector_iterator &a, const static_vector_iterator &b)
+        {
+            return a.p_ - b.p_;
+        }
+
+        friend bool
+        operator==(const static_vector_iterator &a, const static_vector_iterator &b) = default;
+
+        friend auto
+        operator<=>(const static_vector_iterator &a, const static_vector_iterator &b) = default;
+
+      private:
+        template <typename, std::size_t>
+        friend class static_vector;
+        friend class static_vector_iterator<T, !Const>;
+
+        explicit static_vector_iterator(pointer p) : p_(p)
+        {
+        }
+
+        pointer p_{};
+    };
+
+    template <typename T, std::size_t N>
+    class static_vector
+    {
+        static_assert(N > 0);
+
+      public:
+        using value_type             = T;
+        using size_type              = std::size_t;
+        using difference_type        = std::ptrdiff_t;
+        using reference              = T &;
+        using const_reference        = const T &;
+        using pointer                = T *;
+        using const_pointer          = const T *;
+        using iterator               = static_vector_iterator<T, false>;
+        using const_iterator         = static_vector_iterator<T, true>;
+        using reverse_iterator       = std::reverse_iterator<iterator>;
+        using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+        static_vector() = default;
+
+        explicit static_vector(size_type count)
+        {
+            resize(count);
+        }
+
+        static_vector(size_type count, const T &value)
+        {
+            assign(count, value);
+        }
+
+        template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        static_vector(InputIt first, InputIt last)
+        {
+            assign(first, last);
+        }
+
+        static_vector(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+        }
+
+        // trivial when T's are (that is what makes static_vector trivially copyable), element-wise otherwise
+
+        static_vector(const static_vector &)
+            requires std::is_trivially_copy_constructible_v<T>
+        = default;
+
+        static_vector(const static_vector &other)
+        {
+            std::uninitialized_copy(other.begin(), other.end(), data());
+            size_ = other.size_;
+        }
+
+        static_vector(static_vector &&)
+            requires std::is_trivially_move_constructible_v<T>
+        = default;
+
+        static_vector(static_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            std::uninitialized_move(other.begin(), other.end(), data());
+            size_ = other.size_;
+        }
+
+        static_vector &
+        operator=(const static_vector &)
+            requires std::is_trivially_copy_assignable_v<T> && std::is_trivially_copy_constructible_v<T> &&
+                     std::is_trivially_destructible_v<T>
+        = default;
+
+        static_vector &
+        operator=(const static_vector &other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        static_vector &
+        operator=(static_vector &&)
+            requires std::is_trivially_move_assignable_v<T> && std::is_trivially_move_constructible_v<T> &&
+                     std::is_trivially_destructible_v<T>
+        = default;
+
+        static_vector &
+        operator=(static_vector &&other) noexcept(std::is_nothrow_move_assignable_v<T> &&
+                                                  std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this != &other)
+            {
+                size_type common = std::min(size(), other.size());
+                std::move(other.begin(), other.begin() + common, begin());
+                if (size() > other.size())
+                {
+                    std::destroy(begin() + common, end());
+                }
+                else
+                {
+                    std::uninitialized_move(other.begin() + common, other.end(), end());
+                }
+                size_ = other.size_;
+            }
+            return *this;
+        }
+
+        static_vector &
+        operator=(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+            return *this;
+        }
+
+        ~static_vector()
+            requires std::is_trivially_destructible_v<T>
+        = default;
+
+        ~static_vector()
+        {
+            clear();
+        }
+
+        void
+        assign(size_type count, const T &value)
+        {
+            check_capacity(count);
+            clear();
+            std::uninitialized_fill_n(data(), count, value);
+            size_ = static_cast<size_t_>(count);
+        }
+
+        template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        void
+        assign(InputIt first, InputIt last)
+        {
+            clear();
+            for (; first != last; ++first)
+            {
+                emplace_back(*first);
+            }
+        }
+
+        void
+        assign(std::initializer_list<T> init)
+        {
+            assign(init.begin(), init.end());
+        }
+
+        // element access
+
+        reference
+        at(size_type i)
+        {
+            if (i >= size())
+            {
+                throw std::out_of_range("static_vector::at");
+            }
+            return data()[i];
+        }
+
+        const_reference
+        at(size_type i) const
+        {
+            if (i >= size())
+            {
+                throw std::out_of_range("static_vector::at");
+            }
+            return data()[i];
+        }
+
+        reference
+        operator[](size_type i)
+        {
+            return data()[i];
+        }
+
+        const_reference
+        operator[](size_type i) const
+        {
+            return data()[i];
+        }
+
+        reference
+        front()
+        {
+            return data()[0];
+        }
+
+        const_reference
+        front() const
+        {
+            return data()[0];
+        }
+
+        reference
+        back()
+        {
+            return data()[size() - 1];
+        }
+
+        const_reference
+        back() const
+        {
+            return data()[size() - 1];
+        }
+
+        T *
+        data() noexcept
+        {
+            return &slots_[0].value;
+        }
+
+        const T *
+        data() const noexcept
+        {
+            return &slots_[0].value;
+        }
+
+        // iterators
+
+        iterator
+        begin() noexcept
+        {
+            return iterator(data());
+        }
+
+        const_iterator
+        begin() const noexcept
+        {
+            return const_iterator(data());
+        }
+
+        const_iterator
+        cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        iterator
+        end() noexcept
+        {
+            return iterator(data() + size_);
+        }
+
+        const_iterator
+        end() const noexcept
+        {
+            return const_iterator(data() + size_);
+        }
+
+        const_iterator
+        cend() const noexcept
+        {
+            return end();
+        }
+
+        reverse_iterator
+        rbegin() noexcept
+        {
+            return reverse_iterator(end());
+        }
+
+        const_reverse_iterator
+        rbegin() const noexcept
+        {
+            return const_reverse_iterator(end());
+        }
+
+        const_reverse_iterator
+        crbegin() const noexcept
+        {
+            return rbegin();
+        }
+
+        reverse_iterator
+        rend() noexcept
+        {
+            return reverse_iterator(begin());
+        }
+
+        const_reverse_iterator
+        rend() const noexcept
+        {
+            return const_reverse_iterator(begin());
+        }
+
+        const_reverse_iterator
+        crend() const noexcept
+        {
+            return rend();
+        }
+
+        // capacity
+
+        bool
+        empty() const noexcept
+        {
+            return size_ == 0;
+        }
+
+        size_type
+        size() const noexcept
+        {
+            return size_;
+        }
+
+        static constexpr size_type
+        max_size() noexcept
+        {
+            return N;
+        }
+
+        static constexpr size_type
+        capacity() noexcept
+        {
+            return N;
+        }
+
+        // nothing to reserve; only checks that `n` fits
+        void
+        reserve(size_type n)
+        {
+            check_capacity(n);
+        }
+
+        void
+        shrink_to_fit() noexcept
+        {
+        }
+
+        // modifiers
+
+        void
+        clear() noexcept
+        {
+            std::destroy(begin(), end());
+            size_ = 0;
+        }
+
+        iterator
+        insert(const_iterator pos, const T &value)
+        {
+            return emplace(pos, value);
+        }
+
+        iterator
+        insert(const_iterator pos, T &&value)
+        {
+            return emplace(pos, std::move(value));
+        }
+
+        iterator
+        insert(const_iterator pos, size_type count, const T &value)
+        {
+            check_capacity(size() + count);
+            size_type at = pos - cbegin();
+            for (size_type i = 0; i < count; i++)
+            {
+                push_back(value);
+            }
+            std::rotate(begin() + at, end() - count, end());
+            return begin() + at;
+        }
+
+        template <typename InputIt, typename = std::enable_if_t<!std::is_integral_v<InputIt>>>
+        iterator
+        insert(const_iterator pos, InputIt first, InputIt last)
+        {
+            size_type at  = pos - cbegin();
+            size_type old = size();
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag,
+                                            typename std::iterator_traits<InputIt>::iterator_category>)
+            {
+                // nothing is appended if the range doesn't fit
+                check_capacity(old + static_cast<size_type>(std::distance(first, last)));
+                for (; first != last; ++first)
+                {
+                    emplace_back(*first);
+                }
+            }
+            else
+            {
+                // a single pass: the size is only known at the end, so undo the appends if it doesn't fit
+                try
+                {
+                    for (; first != last; ++first)
+                    {
+                        emplace_back(*first);
+                    }
+                }
+                catch (...)
+                {
+                    erase(begin() + old, end());
+                    throw;
+                }
+            }
+            std::rotate(begin() + at, begin() + old, end());
+            return begin() + at;
+        }
+
+        iterator
+        insert(const_iterator pos, std::initializer_list<T> init)
+        {
+            return insert(pos, init.begin(), init.end());
+        }
+
+        template <typename... Args>
+        iterator
+        emplace(const_iterator pos, Args &&...args)
+        {
+            size_type at = pos - cbegin();
+            emplace_back(std::forward<Args>(args)...);
+            std::rotate(begin() + at, end() - 1, end());
+            return begin() + at;
+        }
+
+        iterator
+        erase(const_iterator pos)
+        {
+            return erase(pos, pos + 1);
+        }
+
+        iterator
+        erase(const_iterator first, const_iterator last)
+        {
+            iterator f = begin() + (first - cbegin());
+            iterator l = begin() + (last - cbegin());
+            if (f != l)
+            {
+                iterator new_end = std::move(l, end(), f);
+                std::destroy(new_end, end());
+                size_ = static_cast<size_t_>(new_end - begin());
+            }
+            return f;
+        }
+
+        void
+        push_back(const T &value)
+        {
+            emplace_back(value);
+        }
+
+        void
+        push_back(T &&value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        template <typename... Args>
+        reference
+        emplace_back(Args &&...args)
+        {
+            check_capacity(size() + 1);
+            T *p = std::construct_at(data() + size_, std::forward<Args>(args)...);
+            size_++;
+            return *p;
+        }
+
+        void
+        pop_back()
+        {
+            std::destroy_at(data() + size_ - 1);
+            size_--;
+        }
+
+        void
+        resize(size_type count)
+        {
+            check_capacity(count);
+            if (count < size())
+            {
+                std::destroy(begin() + count, end());
+            }
+            else
+            {
+                std::uninitialized_value_construct(end(), begin() + count);
+            }
+            size_ = static_cast<size_t_>(count);
+        }
+
+        void
+        resize(size_type count, const T &value)
+        {
+            check_capacity(count);
+            if (count < size())
+            {
+                std::destroy(begin() + count, end());
+            }
+            else
+            {
+                std::uninitialized_fill(end(), begin() + count, value);
+            }
+            size_ = static_cast<size_t_>(count);
+        }
+
+        // O(size()), unlike std::vector::swap: the elements themselves are exchanged
+        void
+        swap(static_vector &other) noexcept(std::is_nothrow_swappable_v<T> && std::is_nothrow_move_constructible_v<T>)
+        {
+            static_vector &shorter = size() < other.size() ? *this : other;
+            static_vector &longer  = size() < other.size() ? other : *this;
+            size_type      common  = shorter.size();
+            std::swap_ranges(shorter.begin(), shorter.begin() + common, longer.begin());
+            std::uninitialized_move(longer.begin() + common, longer.end(), shorter.end());
+            std::destroy(longer.begin() + common, longer.end());
+            std::swap(size_, other.size_);
+        }
+
+        friend void
+        swap(static_vector &a, static_vector &b) noexcept(noexcept(a.swap(b)))
+        {
+            a.swap(b);
+        }
+
+        friend bool
+        operator==(const static_vector &a, const static_vector &b)
+        {
+            return std::equal(a.begin(), a.end(), b.begin(), b.end());
+        }
+
+        friend auto
+        operator<=>(const static_vector &a, const static_vector &b)
+        {
+            return std::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+        }
+
+      private:
+        using size_t_ = detail::vector_size_t<N>;
+
+        static void
+        check_capacity(size_type n)
+        {
+            if (n > N)
+            {
+                throw std::length_error("static_vector: capacity exceeded");
+            }
+        }
+
+        std::array<detail::vector_slot<T>, N> slots_;
+        size_t_                               size_ = 0;
+    };
+
+} // namespace class_templates
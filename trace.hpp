@@ -0,0 +1,250 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define TRACE_RDTSC 1
+#else
+#include <time.h>
+#define TRACE_RDTSC 0
+#endif
+
+#include "format.hpp" // the JSON export
+
+// Scoped tracing, for seeing where the time goes inside main()'s sections and the hot paths below them:
+//
+//   void f()
+//   {
+//       TRACE_SCOPE("f");   // one complete event, from here to the end of the block, on this thread's track
+//       ...
+//   }
+//
+//   tracing::write_chrome_json("trace.json");   // open in ui.perfetto.dev or chrome://tracing
+//
+// TRACE_SCOPE expands to nothing unless the build defines TRACING=1 (meson: -Dtracing=true). Define it for
+// the whole program, not per file: the templates that use TRACE_SCOPE must be compiled the same way everywhere.
+// `f --trace=FILE` writes the trace of the sections it ran; every section is one event, and the parallel
+// algorithms' leaves and expression evaluations are events inside it.
+//
+// Each thread records into its own ring buffer (no locks, no allocation, no atomic read-modify-write: one
+// timestamp at each end and a 32-byte store). Timestamps are rdtsc on x86 (converted to time with the TSC rate
+// measured between the first use and the export) and clock_gettime(CLOCK_MONOTONIC) elsewhere. A ring holds
+// the last 16384 events of its thread; older ones are overwritten. Rings outlive their threads, so the export
+// sees pool workers that have already exited. Export once the traced threads are idle (e.g. at the end of main):
+// it reads the rings without synchronizing with writers.
+//
+// Names are not copied: pass string literals (or anything else that outlives the export).
+
+#ifndef TRACING
+#define TRACING 0
+#endif
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b)  TRACE_CONCAT_(a, b)
+
+#if TRACING
+#define TRACE_SCOPE(name) ::tracing::scope TRACE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace tracing
+{
+    inline constexpr bool enabled = TRACING;
+
+    // rdtsc ticks, or nanoseconds
+    inline std::uint64_t
+    now() noexcept
+    {
+#if TRACE_RDTSC
+        return __rdtsc();
+#else
+        timespec t;
+        clock_gettime(CLOCK_MONOTONIC, &t);
+        return std::uint64_t(t.tv_sec) * 1000000000u + std::uint64_t(t.tv_nsec);
+#endif
+    }
+
+    struct event
+    {
+        std::string_view name;
+        std::uint64_t    begin;
+        std::uint64_t    end;
+    };
+
+    // one thread's events; written by that thread only
+    struct ring
+    {
+        static constexpr std::size_t capacity = 1 << 14;
+
+        std::array<event, capacity> events;
+        std::atomic<std::uint64_t>  written{0};
+        unsigned                    tid = 0;
+
+        void
+        record(std::string_view name, std::uint64_t begin, std::uint64_t end) noexcept
+        {
+            std::uint64_t w      = written.load(std::memory_order_relaxed);
+            events[w % capacity] = {name, begin, end};
+            written.store(w + 1, std::memory_order_release);
+        }
+    };
+
+    class collector
+    {
+      public:
+        // never destroyed: threads may still record during static destruction
+        static collector &
+        global()
+        {
+            static collector *c = new collector;
+            return *c;
+        }
+
+        collector(const collector &) = delete;
+        collector &
+        operator=(const collector &) = delete;
+
+        // the calling thread's ring, registered on first use (the only lock)
+        ring &
+        this_thread()
+        {
+            static thread_local ring *mine = nullptr;
+            if (!mine) [[unlikely]]
+            {
+                auto            r = std::make_unique<ring>();
+                std::lock_guard lock(m_);
+                r->tid = static_cast<unsigned>(rings_.size());
+                mine   = r.get();
+                rings_.push_back(std::move(r));
+            }
+            return *mine;
+        }
+
+        // Chrome trace event format: one complete ("X") event per scope, timestamps in microseconds since the
+        // collector was created. False if the file can't be written.
+        bool
+        write_chrome_json(const std::string &path)
+        {
+            std::FILE *file = std::fopen(path.c_str(), "w");
+            if (!file)
+            {
+                return false;
+            }
+            double us_per_tick = ticks_to_us();
+            bool   ok;
+            {
+                formatting::sink out(file);
+                print(out, "{{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+                bool            first = true;
+                std::lock_guard lock(m_);
+                for (const auto &r : rings_)
+                {
+                    print(out, "{}{{\"name\": \"thread {}\", \"ph\": \"M\", \"pid\": 1, \"tid\": {}, "
+                               "\"args\": {{\"name\": \"thread {}\"}}}}",
+                          first ? "" : ",\n", r->tid, r->tid, r->tid);
+                    first = false;
+
+                    std::uint64_t written = r->written.load(std::memory_order_acquire);
+                    std::uint64_t oldest  = written > ring::capacity ? written - ring::capacity : 0;
+                    for (std::uint64_t i = oldest; i < written; i++)
+                    {
+                        const event &e = r->events[i % ring::capacity];
+                        print(out, ",\n{{\"name\": \"");
+                        escape(out, e.name);
+                        print(out, "\", \"ph\": \"X\", \"pid\": 1, \"tid\": {}, \"ts\": {:.3f}, \"dur\": {:.3f}}}",
+                              r->tid, double(e.begin - origin_) * us_per_tick, double(e.end - e.begin) * us_per_tick);
+                    }
+                }
+                print(out, "\n]}}\n");
+                out.flush();
+                ok = bool(out);
+            }
+            return std::fclose(file) == 0 && ok;
+        }
+
+      private:
+        collector() : origin_(now()), origin_time_(std::chrono::steady_clock::now())
+        {
+        }
+
+        double
+        ticks_to_us() const
+        {
+#if TRACE_RDTSC
+            std::uint64_t                             ticks = now() - origin_;
+            std::chrono::duration<double, std::micro> us    = std::chrono::steady_clock::now() - origin_time_;
+            return ticks ? us.count() / double(ticks) : 0;
+#else
+            return 1e-3;
+#endif
+        }
+
+        static void
+        escape(formatting::sink &out, std::string_view s)
+        {
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    out.buf().push_back('\\');
+                    out.buf().push_back(c);
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    print(out, "\\u00{}{}", "0123456789abcdef"[c >> 4], "0123456789abcdef"[c & 15]);
+                }
+                else
+                {
+                    out.buf().push_back(c);
+                }
+            }
+        }
+
+        std::uint64_t                         origin_;
+        std::chrono::steady_clock::time_point origin_time_;
+        std::mutex                            m_;
+        std::vector<std::unique_ptr<ring>>    rings_;
+    };
+
+    // one event from construction to destruction; see TRACE_SCOPE
+    class scope
+    {
+      public:
+        explicit scope(std::string_view name) : ring_(collector::global().this_thread()), name_(name), begin_(now())
+        {
+        }
+
+        scope(const scope &) = delete;
+        scope &
+        operator=(const scope &) = delete;
+
+        ~scope()
+        {
+            ring_.record(name_, begin_, now());
+        }
+
+      private:
+        ring            &ring_;
+        std::string_view name_;
+        std::uint64_t    begin_;
+    };
+
+    inline bool
+    write_chrome_json(const std::string &path)
+    {
+        return collector::global().write_chrome_json(path);
+    }
+
+} // namespace tracing
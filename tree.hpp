@@ -0,0 +1,1006 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "generator.hpp"
+
+namespace good_tag_dispatch
+{
+    // tree<Element> is an ordered set stored as a B+ tree: wide internal nodes for lookup, and all elements in
+    // leaves that are linked into one circular list. So ++ on a tree_iterator is an index bump inside a leaf and
+    // only follows a pointer at the end of a leaf. There is still no `+`, hence `supports_plus = false_type`.
+    //
+    // Invariant for internal nodes: everything in children[i] < keys[i] <= everything in children[i + 1].
+    // Internal nodes also count the elements below every child (order statistics), which gives rank/select and
+    // lets tree_iterator::jump(n) skip n elements in O(log n) (`supports_logarithmic_jump`).
+    // Iterator invalidation: insert and erase may move elements between neighboring leaves, so they invalidate
+    // iterators into the leaves they touch (erase returns a valid iterator to the next element).
+
+    namespace detail
+    {
+        // Slot arrays: raw storage where only [0, count) holds constructed elements.
+
+        template <typename T, typename... Args>
+        void
+        slots_emplace(T *data, std::size_t count, std::size_t i, Args &&...args)
+        {
+            if (i == count)
+            {
+                ::new (static_cast<void *>(data + i)) T(std::forward<Args>(args)...);
+                return;
+            }
+            T tmp(std::forward<Args>(args)...);
+            ::new (static_cast<void *>(data + count)) T(std::move(data[count - 1]));
+            std::move_backward(data + i, data + count - 1, data + count);
+            data[i] = std::move(tmp);
+        }
+
+        template <typename T>
+        void
+        slots_erase(T *data, std::size_t count, std::size_t i)
+        {
+            std::move(data + i + 1, data + count, data + i);
+            std::destroy_at(data + count - 1);
+        }
+
+        // moves n constructed slots to uninitialized storage and destroys the originals
+        template <typename T>
+        void
+        slots_relocate(T *from, std::size_t n, T *to)
+        {
+            std::uninitialized_move(from, from + n, to);
+            std::destroy(from, from + n);
+        }
+
+        template <typename Element>
+        struct tree_nodes
+        {
+            struct internal;
+
+            struct base
+            {
+                internal     *parent;
+                std::uint32_t count; // leaf: elements, internal: children, sentinel: 0
+                bool          is_leaf;
+            };
+
+            struct leaf_link : base
+            {
+                leaf_link *next;
+                leaf_link *prev;
+            };
+
+            static constexpr std::size_t leaf_bytes     = 256;
+            static constexpr std::size_t internal_bytes = 512;
+
+            static constexpr std::size_t leaf_capacity =
+                std::max<std::size_t>(8, (leaf_bytes - sizeof(leaf_link)) / sizeof(Element));
+            static constexpr std::size_t fanout = std::max<std::size_t>(
+                4, (internal_bytes - sizeof(base)) / (sizeof(Element) + sizeof(void *) + sizeof(std::size_t)));
+
+            struct alignas(64) leaf : leaf_link
+            {
+                alignas(Element) unsigned char storage[leaf_capacity * sizeof(Element)];
+
+                Element *
+                data()
+                {
+                    return std::launder(reinterpret_cast<Element *>(storage));
+                }
+            };
+
+            struct alignas(64) internal : base
+            {
+                base       *children[fanout];
+                std::size_t sizes[fanout]; // number of elements below each child
+                alignas(Element) unsigned char storage[(fanout - 1) * sizeof(Element)];
+
+                Element *
+                keys()
+                {
+                    return std::launder(reinterpret_cast<Element *>(storage));
+                }
+            };
+
+            static std::size_t
+            index_in_parent(const base *n)
+            {
+                const internal *p = n->parent;
+                return std::find(p->children, p->children + p->count, n) - p->children;
+            }
+
+            static std::size_t
+            subtree_size(const base *n)
+            {
+                if (n->is_leaf)
+                {
+                    return n->count;
+                }
+                const internal *in = static_cast<const internal *>(n);
+                return std::accumulate(in->sizes, in->sizes + in->count, std::size_t(0));
+            }
+
+            // Number of elements before element i of leaf l, and the root reached on the way up.
+            static std::pair<std::size_t, base *>
+            rank(base *l, std::size_t i)
+            {
+                std::size_t r = i;
+                base       *n = l;
+                for (; n->parent != nullptr; n = n->parent)
+                {
+                    const internal *p = n->parent;
+                    r += std::accumulate(p->sizes, p->sizes + index_in_parent(n), std::size_t(0));
+                }
+                return {r, n};
+            }
+
+            // Leaf and index of the element with rank k (k < subtree_size(root)).
+            static std::pair<leaf *, std::size_t>
+            select(base *root, std::size_t k)
+            {
+                base *n = root;
+                while (!n->is_leaf)
+                {
+                    internal   *in = static_cast<internal *>(n);
+                    std::size_t c  = 0;
+                    while (k >= in->sizes[c])
+                    {
+                        k -= in->sizes[c];
+                        c++;
+                    }
+                    n = in->children[c];
+                }
+                return {static_cast<leaf *>(n), k};
+            }
+        };
+
+    } // namespace detail
+
+    template <typename Element, typename Compare>
+    class tree;
+
+    template <typename Element>
+    struct tree_iterator
+    {
+      private:
+        using nodes     = detail::tree_nodes<Element>;
+        using leaf_link = typename nodes::leaf_link;
+        using leaf      = typename nodes::leaf;
+
+      public:
+        using iterator_category         = std::bidirectional_iterator_tag;
+        using value_type                = Element;
+        using difference_type           = std::ptrdiff_t;
+        using pointer                   = const Element *;
+        using reference                 = const Element &; // elements are keys: never modifiable in place
+        using supports_plus             = std::false_type;
+        using supports_logarithmic_jump = std::true_type;
+        using supports_segments         = std::true_type; // see segmented.hpp
+
+        tree_iterator() = default;
+
+        reference
+        operator*() const
+        {
+            return static_cast<leaf *>(node_)->data()[index_];
+        }
+
+        pointer
+        operator->() const
+        {
+            return &**this;
+        }
+
+        tree_iterator &
+        operator++()
+        {
+            if (++index_ == node_->count)
+            {
+                node_  = node_->next;
+                index_ = 0;
+            }
+            return *this;
+        }
+
+        tree_iterator
+        operator++(int)
+        {
+            tree_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        tree_iterator &
+        operator--()
+        {
+            if (index_ == 0)
+            {
+                node_  = node_->prev;
+                index_ = node_->count;
+            }
+            --index_;
+            return *this;
+        }
+
+        tree_iterator
+        operator--(int)
+        {
+            tree_iterator tmp = *this;
+            --*this;
+            return tmp;
+        }
+
+        // Same as n times ++ (or -n times -- for negative n), but O(log n): stays inside the leaf if it can,
+        // otherwise computes its rank from the subtree sizes on the way up and selects rank + n on the way down.
+        tree_iterator
+        jump(difference_type n) const
+        {
+            leaf_link  *l = node_;
+            std::size_t i = index_;
+            if (l->count == 0)
+            {
+                // end(): count from the back of the last leaf
+                if (n == 0)
+                {
+                    return *this;
+                }
+                l = l->prev;
+                i = l->count;
+            }
+
+            difference_type target = static_cast<difference_type>(i) + n;
+            if (target >= 0 && target < static_cast<difference_type>(l->count))
+            {
+                return tree_iterator(l, static_cast<std::size_t>(target));
+            }
+
+            auto [r, root]  = nodes::rank(l, i);
+            std::size_t k   = r + static_cast<std::size_t>(n);
+            bool        end = k == nodes::subtree_size(root);
+            auto [lf, idx]  = nodes::select(root, end ? k - 1 : k);
+            tree_iterator it(lf, idx);
+            return end ? ++it : it;
+        }
+
+        // segmented iterator protocol (see segmented.hpp): a segment is the contiguous run of elements in one leaf
+
+        std::span<const Element>
+        segment() const
+        {
+            return {&**this, node_->count - index_};
+        }
+
+        std::span<const Element>
+        segment_until(const tree_iterator &last) const
+        {
+            return same_segment(last) ? segment().first(last.index_ - index_) : segment();
+        }
+
+        bool
+        same_segment(const tree_iterator &other) const
+        {
+            return node_ == other.node_;
+        }
+
+        tree_iterator
+        next_segment() const
+        {
+            return tree_iterator(node_->next, 0);
+        }
+
+        tree_iterator
+        local_advance(std::size_t k) const
+        {
+            return k == node_->count - index_ ? next_segment() : tree_iterator(node_, index_ + k);
+        }
+
+        friend bool
+        operator==(const tree_iterator &a, const tree_iterator &b)
+        {
+            return a.node_ == b.node_ && a.index_ == b.index_;
+        }
+
+      private:
+        template <typename, typename>
+        friend class tree;
+
+        tree_iterator(leaf_link *n, std::size_t i) : node_(n), index_(static_cast<std::uint32_t>(i))
+        {
+        }
+
+        leaf_link    *node_{};
+        std::uint32_t index_{};
+    };
+
+    template <typename Element, typename Compare = std::less<Element>>
+    class tree
+    {
+        using nodes     = detail::tree_nodes<Element>;
+        using base      = typename nodes::base;
+        using leaf_link = typename nodes::leaf_link;
+        using leaf      = typename nodes::leaf;
+        using internal  = typename nodes::internal;
+
+        static constexpr std::size_t leaf_capacity = nodes::leaf_capacity;
+        static constexpr std::size_t fanout        = nodes::fanout;
+        static constexpr std::size_t min_leaf      = leaf_capacity / 2;
+        static constexpr std::size_t min_children  = fanout / 2;
+
+      public:
+        using value_type     = Element;
+        using key_type       = Element;
+        using size_type      = std::size_t;
+        using key_compare    = Compare;
+        using iterator       = tree_iterator<Element>;
+        using const_iterator = tree_iterator<Element>;
+
+        tree() = default;
+
+        explicit tree(const Compare &comp) : comp_(comp)
+        {
+        }
+
+        tree(std::initializer_list<Element> init)
+        {
+            for (const Element &x : init)
+            {
+                insert(x);
+            }
+        }
+
+        tree(const tree &other) : comp_(other.comp_)
+        {
+            for (const Element &x : other)
+            {
+                insert(x);
+            }
+        }
+
+        tree(tree &&other) noexcept : comp_(other.comp_)
+        {
+            steal(other);
+        }
+
+        tree &
+        operator=(const tree &other)
+        {
+            if (this != &other)
+            {
+                tree tmp(other);
+                clear();
+                comp_ = tmp.comp_;
+                steal(tmp);
+            }
+            return *this;
+        }
+
+        tree &
+        operator=(tree &&other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                comp_ = other.comp_;
+                steal(other);
+            }
+            return *this;
+        }
+
+        ~tree()
+        {
+            clear();
+        }
+
+        iterator
+        begin() const
+        {
+            return iterator(head_.next, 0);
+        }
+
+        iterator
+        end() const
+        {
+            return iterator(const_cast<leaf_link *>(&head_), 0);
+        }
+
+        bool
+        empty() const
+        {
+            return size_ == 0;
+        }
+
+        size_type
+        size() const
+        {
+            return size_;
+        }
+
+        // lookup
+
+        iterator
+        lower_bound(const Element &x) const
+        {
+            if (root_ == nullptr)
+            {
+                return end();
+            }
+            leaf       *l = find_leaf(x);
+            std::size_t i = std::lower_bound(l->data(), l->data() + l->count, x, comp_) - l->data();
+            return normalize(l, i);
+        }
+
+        iterator
+        upper_bound(const Element &x) const
+        {
+            if (root_ == nullptr)
+            {
+                return end();
+            }
+            leaf       *l = find_leaf(x);
+            std::size_t i = std::upper_bound(l->data(), l->data() + l->count, x, comp_) - l->data();
+            return normalize(l, i);
+        }
+
+        iterator
+        find(const Element &x) const
+        {
+            iterator it = lower_bound(x);
+            return (it != end() && !comp_(x, *it)) ? it : end();
+        }
+
+        bool
+        contains(const Element &x) const
+        {
+            return find(x) != end();
+        }
+
+        size_type
+        count(const Element &x) const
+        {
+            return contains(x) ? 1 : 0;
+        }
+
+        // order statistics
+
+        // number of elements before `pos` (size() for end())
+        size_type
+        rank(iterator pos) const
+        {
+            if (pos.node_ == &head_)
+            {
+                return size_;
+            }
+            return nodes::rank(pos.node_, pos.index_).first;
+        }
+
+        // number of elements less than x
+        size_type
+        rank(const Element &x) const
+        {
+            return rank(lower_bound(x));
+        }
+
+        // iterator to the element with rank k, end() for k >= size()
+        iterator
+        select(size_type k) const
+        {
+            if (k >= size_)
+            {
+                return end();
+            }
+            auto [l, i] = nodes::select(root_, k);
+            return iterator(l, i);
+        }
+
+        // One entry per node, breadth-first from the root: the separator keys of an internal node, the elements of a
+        // leaf. It shows the shape of the tree, and being lazy it can stop after the top levels. In-order traversal
+        // is just begin()..end() (or coroutines::in_order).
+        struct node_view
+        {
+            std::size_t              depth;
+            bool                     is_leaf;
+            std::span<const Element> keys;
+        };
+
+        coroutines::generator<node_view>
+        level_order() const
+        {
+            if (root_ == nullptr)
+            {
+                co_return;
+            }
+            std::vector<std::pair<base *, std::size_t>> queue{{root_, 0}};
+            for (std::size_t q = 0; q < queue.size(); q++)
+            {
+                auto [n, depth] = queue[q];
+                if (n->is_leaf)
+                {
+                    leaf *l = static_cast<leaf *>(n);
+                    co_yield node_view{depth, true, {l->data(), l->count}};
+                    continue;
+                }
+                internal *in = static_cast<internal *>(n);
+                co_yield node_view{depth, false, {in->keys(), in->count - 1}};
+                for (std::size_t c = 0; c < in->count; c++)
+                {
+                    queue.push_back({in->children[c], depth + 1});
+                }
+            }
+        }
+
+        // modifiers
+
+        std::pair<iterator, bool>
+        insert(const Element &x)
+        {
+            return emplace(x);
+        }
+
+        std::pair<iterator, bool>
+        insert(Element &&x)
+        {
+            return emplace(std::move(x));
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool>
+        emplace(Args &&...args)
+        {
+            Element x(std::forward<Args>(args)...);
+
+            if (root_ == nullptr)
+            {
+                leaf *l = new_leaf();
+                link_after(&head_, l);
+                root_ = l;
+            }
+
+            leaf       *l = find_leaf(x);
+            std::size_t i = std::lower_bound(l->data(), l->data() + l->count, x, comp_) - l->data();
+            if (i < l->count && !comp_(x, l->data()[i]))
+            {
+                return {iterator(l, i), false};
+            }
+
+            if (l->count == leaf_capacity)
+            {
+                leaf *right = split_leaf(l);
+                if (i > l->count)
+                {
+                    i -= l->count;
+                    l = right;
+                }
+            }
+            detail::slots_emplace(l->data(), l->count, i, std::move(x));
+            l->count++;
+            size_++;
+            adjust_sizes(l, 1);
+            return {iterator(l, i), true};
+        }
+
+        iterator
+        erase(iterator pos)
+        {
+            leaf       *l = static_cast<leaf *>(pos.node_);
+            std::size_t i = pos.index_;
+
+            detail::slots_erase(l->data(), l->count, i);
+            l->count--;
+            size_--;
+            adjust_sizes(l, -1);
+
+            if (l == root_)
+            {
+                if (l->count == 0)
+                {
+                    unlink(l);
+                    delete l;
+                    root_ = nullptr;
+                    return end();
+                }
+                return normalize(l, i);
+            }
+            if (l->count >= min_leaf)
+            {
+                return normalize(l, i);
+            }
+            return rebalance_leaf(l, i);
+        }
+
+        size_type
+        erase(const Element &x)
+        {
+            iterator it = find(x);
+            if (it == end())
+            {
+                return 0;
+            }
+            erase(it);
+            return 1;
+        }
+
+        void
+        clear()
+        {
+            if (root_ != nullptr)
+            {
+                destroy(root_);
+            }
+            root_      = nullptr;
+            head_.next = head_.prev = &head_;
+            size_                   = 0;
+        }
+
+      private:
+        static leaf *
+        new_leaf()
+        {
+            leaf *l    = new leaf;
+            l->parent  = nullptr;
+            l->count   = 0;
+            l->is_leaf = true;
+            return l;
+        }
+
+        static internal *
+        new_internal()
+        {
+            internal *n = new internal;
+            n->parent   = nullptr;
+            n->count    = 0;
+            n->is_leaf  = false;
+            return n;
+        }
+
+        static void
+        link_after(leaf_link *pos, leaf_link *l)
+        {
+            l->prev         = pos;
+            l->next         = pos->next;
+            pos->next->prev = l;
+            pos->next       = l;
+        }
+
+        static void
+        unlink(leaf_link *l)
+        {
+            l->prev->next = l->next;
+            l->next->prev = l->prev;
+        }
+
+        void
+        destroy(base *n)
+        {
+            if (n->is_leaf)
+            {
+                leaf *l = static_cast<leaf *>(n);
+                std::destroy_n(l->data(), l->count);
+                delete l;
+                return;
+            }
+            internal *in = static_cast<internal *>(n);
+            for (std::size_t c = 0; c < in->count; c++)
+            {
+                destroy(in->children[c]);
+            }
+            std::destroy_n(in->keys(), in->count - 1);
+            delete in;
+        }
+
+        leaf *
+        find_leaf(const Element &x) const
+        {
+            base *n = root_;
+            while (!n->is_leaf)
+            {
+                internal   *in   = static_cast<internal *>(n);
+                Element    *keys = in->keys();
+                std::size_t c    = std::upper_bound(keys, keys + in->count - 1, x, comp_) - keys;
+                n                = in->children[c];
+            }
+            return static_cast<leaf *>(n);
+        }
+
+        iterator
+        normalize(leaf_link *l, std::size_t i) const
+        {
+            return i == l->count ? iterator(l->next, 0) : iterator(l, i);
+        }
+
+        static std::size_t
+        index_in_parent(const base *n)
+        {
+            return nodes::index_in_parent(n);
+        }
+
+        // adds delta to the element count of every ancestor of n
+        static void
+        adjust_sizes(base *n, std::ptrdiff_t delta)
+        {
+            for (internal *p = n->parent; p != nullptr; n = p, p = p->parent)
+            {
+                p->sizes[index_in_parent(n)] += static_cast<std::size_t>(delta);
+            }
+        }
+
+        // insertion
+
+        leaf *
+        split_leaf(leaf *l)
+        {
+            leaf       *right = new_leaf();
+            std::size_t keep  = l->count / 2;
+            detail::slots_relocate(l->data() + keep, l->count - keep, right->data());
+            right->count = l->count - keep;
+            l->count     = static_cast<std::uint32_t>(keep);
+            link_after(l, right);
+            insert_in_parent(l, Element(right->data()[0]), right);
+            return right;
+        }
+
+        void
+        insert_in_parent(base *left, Element &&key, base *right)
+        {
+            internal *p = left->parent;
+            if (p == nullptr)
+            {
+                p              = new_internal();
+                p->children[0] = left;
+                p->children[1] = right;
+                p->sizes[0]    = nodes::subtree_size(left);
+                p->sizes[1]    = nodes::subtree_size(right);
+                ::new (static_cast<void *>(p->keys())) Element(std::move(key));
+                p->count      = 2;
+                left->parent  = p;
+                right->parent = p;
+                root_         = p;
+                return;
+            }
+
+            std::size_t i = index_in_parent(left);
+            if (p->count == fanout)
+            {
+                // split p: children [0, mid) stay, [mid, fanout) move to q, keys[mid - 1] moves up
+                std::size_t mid = fanout / 2;
+                internal   *q   = new_internal();
+                std::copy(p->children + mid, p->children + fanout, q->children);
+                std::copy(p->sizes + mid, p->sizes + fanout, q->sizes);
+                detail::slots_relocate(p->keys() + mid, fanout - 1 - mid, q->keys());
+                Element up(std::move(p->keys()[mid - 1]));
+                std::destroy_at(p->keys() + mid - 1);
+                q->count = static_cast<std::uint32_t>(fanout - mid);
+                p->count = static_cast<std::uint32_t>(mid);
+                for (std::size_t c = 0; c < q->count; c++)
+                {
+                    q->children[c]->parent = q;
+                }
+
+                if (i >= mid)
+                {
+                    insert_child(q, i - mid, std::move(key), right);
+                }
+                else
+                {
+                    insert_child(p, i, std::move(key), right);
+                }
+                insert_in_parent(p, std::move(up), q);
+                return;
+            }
+            insert_child(p, i, std::move(key), right);
+        }
+
+        // Inserts `key` and `right` just after child i of a non-full node; `right` was split off child i, so its
+        // elements are still counted in sizes[i].
+        static void
+        insert_child(internal *p, std::size_t i, Element &&key, base *right)
+        {
+            std::size_t moved = nodes::subtree_size(right);
+            detail::slots_emplace(p->keys(), p->count - 1, i, std::move(key));
+            std::copy_backward(p->children + i + 1, p->children + p->count, p->children + p->count + 1);
+            std::copy_backward(p->sizes + i + 1, p->sizes + p->count, p->sizes + p->count + 1);
+            p->children[i + 1] = right;
+            p->sizes[i]        = p->sizes[i] - moved;
+            p->sizes[i + 1]    = moved;
+            right->parent      = p;
+            p->count++;
+        }
+
+        // Removes keys[i] and children[i + 1] after children[i + 1] was merged into children[i].
+        static void
+        remove_child(internal *p, std::size_t i)
+        {
+            p->sizes[i] += p->sizes[i + 1];
+            detail::slots_erase(p->keys(), p->count - 1, i);
+            std::copy(p->children + i + 2, p->children + p->count, p->children + i + 1);
+            std::copy(p->sizes + i + 2, p->sizes + p->count, p->sizes + i + 1);
+            p->count--;
+        }
+
+        // erasure
+
+        // `l` is short by one; (l, i) is where the element after the erased one lives
+        iterator
+        rebalance_leaf(leaf *l, std::size_t i)
+        {
+            internal   *p = l->parent;
+            std::size_t j = index_in_parent(l);
+            leaf       *left  = j > 0 ? static_cast<leaf *>(p->children[j - 1]) : nullptr;
+            leaf       *right = j + 1 < p->count ? static_cast<leaf *>(p->children[j + 1]) : nullptr;
+
+            if (left != nullptr && left->count > min_leaf)
+            {
+                // borrow the last element of the left sibling
+                detail::slots_emplace(l->data(), l->count, 0, std::move(left->data()[left->count - 1]));
+                std::destroy_at(left->data() + left->count - 1);
+                left->count--;
+                l->count++;
+                p->sizes[j - 1]--;
+                p->sizes[j]++;
+                p->keys()[j - 1] = l->data()[0];
+                return normalize(l, i + 1);
+            }
+            if (right != nullptr && right->count > min_leaf)
+            {
+                // borrow the first element of the right sibling
+                ::new (static_cast<void *>(l->data() + l->count)) Element(std::move(right->data()[0]));
+                detail::slots_erase(right->data(), right->count, 0);
+                right->count--;
+                l->count++;
+                p->sizes[j + 1]--;
+                p->sizes[j]++;
+                p->keys()[j] = right->data()[0];
+                return normalize(l, i);
+            }
+
+            iterator next;
+            if (left != nullptr)
+            {
+                // merge l into its left sibling
+                std::size_t offset = left->count;
+                detail::slots_relocate(l->data(), l->count, left->data() + offset);
+                left->count += l->count;
+                unlink(l);
+                delete l;
+                remove_child(p, j - 1);
+                next = normalize(left, offset + i);
+            }
+            else
+            {
+                // merge the right sibling into l
+                detail::slots_relocate(right->data(), right->count, l->data() + l->count);
+                l->count += right->count;
+                unlink(right);
+                delete right;
+                remove_child(p, j);
+                next = normalize(l, i);
+            }
+            rebalance_internal(p);
+            return next;
+        }
+
+        void
+        rebalance_internal(internal *n)
+        {
+            if (n == root_)
+            {
+                if (n->count == 1)
+                {
+                    root_         = n->children[0];
+                    root_->parent = nullptr;
+                    delete n;
+                }
+                return;
+            }
+            if (n->count >= min_children)
+            {
+                return;
+            }
+
+            internal   *p     = n->parent;
+            std::size_t j     = index_in_parent(n);
+            internal   *left  = j > 0 ? static_cast<internal *>(p->children[j - 1]) : nullptr;
+            internal   *right = j + 1 < p->count ? static_cast<internal *>(p->children[j + 1]) : nullptr;
+
+            if (left != nullptr && left->count > min_children)
+            {
+                // rotate right through the parent separator
+                detail::slots_emplace(n->keys(), n->count - 1, 0, std::move(p->keys()[j - 1]));
+                std::copy_backward(n->children, n->children + n->count, n->children + n->count + 1);
+                std::copy_backward(n->sizes, n->sizes + n->count, n->sizes + n->count + 1);
+                std::size_t moved      = left->sizes[left->count - 1];
+                n->children[0]         = left->children[left->count - 1];
+                n->children[0]->parent = n;
+                n->sizes[0]            = moved;
+                n->count++;
+                p->sizes[j - 1] -= moved;
+                p->sizes[j] += moved;
+                p->keys()[j - 1] = std::move(left->keys()[left->count - 2]);
+                std::destroy_at(left->keys() + left->count - 2);
+                left->count--;
+                return;
+            }
+            if (right != nullptr && right->count > min_children)
+            {
+                // rotate left through the parent separator
+                ::new (static_cast<void *>(n->keys() + n->count - 1)) Element(std::move(p->keys()[j]));
+                std::size_t moved             = right->sizes[0];
+                n->children[n->count]         = right->children[0];
+                n->children[n->count]->parent = n;
+                n->sizes[n->count]            = moved;
+                n->count++;
+                p->sizes[j + 1] -= moved;
+                p->sizes[j] += moved;
+                p->keys()[j] = std::move(right->keys()[0]);
+                detail::slots_erase(right->keys(), right->count - 1, 0);
+                std::copy(right->children + 1, right->children + right->count, right->children);
+                std::copy(right->sizes + 1, right->sizes + right->count, right->sizes);
+                right->count--;
+                return;
+            }
+
+            if (left != nullptr)
+            {
+                merge_internal(left, n, j - 1);
+            }
+            else
+            {
+                merge_internal(n, right, j);
+            }
+            rebalance_internal(p);
+        }
+
+        // appends separator keys[j] of the parent and all of `right` to `left`, then frees `right`
+        void
+        merge_internal(internal *left, internal *right, std::size_t j)
+        {
+            internal *p = left->parent;
+            ::new (static_cast<void *>(left->keys() + left->count - 1)) Element(std::move(p->keys()[j]));
+            detail::slots_relocate(right->keys(), right->count - 1, left->keys() + left->count);
+            for (std::size_t c = 0; c < right->count; c++)
+            {
+                left->children[left->count + c]         = right->children[c];
+                left->children[left->count + c]->parent = left;
+                left->sizes[left->count + c]            = right->sizes[c];
+            }
+            left->count += right->count;
+            delete right;
+            remove_child(p, j);
+        }
+
+        void
+        steal(tree &other)
+        {
+            if (other.head_.next != &other.head_)
+            {
+                head_.next       = other.head_.next;
+                head_.prev       = other.head_.prev;
+                head_.next->prev = &head_;
+                head_.prev->next = &head_;
+            }
+            root_ = other.root_;
+            size_ = other.size_;
+
+            other.root_      = nullptr;
+            other.head_.next = other.head_.prev = &other.head_;
+            other.size_                         = 0;
+        }
+
+        base       *root_{};
+        leaf_link   head_{{nullptr, 0, true}, &head_, &head_}; // sentinel of the circular leaf list
+        std::size_t size_{};
+        Compare     comp_{};
+    };
+
+} // namespace good_tag_dispatch
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace type_names
+{
+    // type_name<T>(): how the compiler spells T, as a std::string_view computed at compile time.
+    //
+    //   static_assert(type_name<const int &>() == "const int&");   // GCC; Clang writes "const int &"
+    //   std::cout << type_name<T>();                                // instead of puts(__PRETTY_FUNCTION__)
+    //
+    // Unlike typeid(T).name() it keeps cv-qualifiers and references (type_name<int &&>() is "int&&", not "int"),
+    // needs no RTTI and no demangling, and costs nothing at run time: the spelling is cut out of the
+    // __PRETTY_FUNCTION__ of a function template instantiated for T, copied into a static char array of exactly
+    // its length (so the rest of the signature doesn't end up in the binary) and returned as a view of it.
+    //
+    // Where the name starts and ends is measured on type_name<int>, so whatever the compiler writes around it
+    // (GCC: "... [with T = int]", Clang: "... [T = int]", MSVC: "...<int>(void)") needs no parsing. The spelling
+    // itself is the compiler's: spacing around * and &, std::__cxx11:: and the like, and default template
+    // arguments (std::vector<int, std::allocator<int> >) differ between compilers and standard libraries.
+
+    namespace detail
+    {
+        template <typename T>
+        constexpr std::string_view
+        signature()
+        {
+#if defined(_MSC_VER) && !defined(__clang__)
+            return __FUNCSIG__;
+#else
+            return __PRETTY_FUNCTION__;
+#endif
+        }
+
+        // the text around the name, the same for every T
+        inline constexpr std::size_t prefix = signature<int>().find("int");
+        inline constexpr std::size_t suffix = signature<int>().size() - prefix - 3;
+
+        static_assert(prefix != std::string_view::npos, "type_names: unknown __PRETTY_FUNCTION__ format");
+
+        template <typename T>
+        constexpr auto
+        spelling()
+        {
+            constexpr std::string_view s = signature<T>();
+            constexpr std::size_t      n = s.size() - prefix - suffix;
+            std::array<char, n + 1>    name{}; // NUL-terminated, for C APIs
+            for (std::size_t i = 0; i < n; i++)
+            {
+                name[i] = s[prefix + i];
+            }
+            return name;
+        }
+
+        template <typename T>
+        inline constexpr auto storage = spelling<T>();
+
+    } // namespace detail
+
+    template <typename T>
+    constexpr std::string_view
+    type_name() noexcept
+    {
+        return {detail::storage<T>.data(), detail::storage<T>.size() - 1};
+    }
+
+} // namespace type_names
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// __type_pack_element: clang, GCC >= 14. Without it, at_t falls back to overload resolution over an index-tagged
+// base list, which is still constant depth.
+#if defined(__has_builtin)
+#if __has_builtin(__type_pack_element)
+#define TYPE_LISTS_PACK_ELEMENT 1
+#endif
+#endif
+#ifndef TYPE_LISTS_PACK_ELEMENT
+#define TYPE_LISTS_PACK_ELEMENT 0
+#endif
+
+// __is_same: clang, GCC >= 10. Compares without instantiating std::is_same_v, which matters in unique_t (N^2 tests).
+#if defined(__has_builtin)
+#if __has_builtin(__is_same)
+#define TYPE_LISTS_IS_SAME(T, U) __is_same(T, U)
+#endif
+#endif
+#ifndef TYPE_LISTS_IS_SAME
+#define TYPE_LISTS_IS_SAME(T, U) std::is_same_v<T, U>
+#endif
+
+namespace type_lists
+{
+    // Type-list operations that instantiate in constant depth.
+    //
+    // The classic way (see which_specialization_is_called::A<T **> or a recursive is_same fold) peels off one type per
+    // partial specialization. A list of N types then needs N nested instantiations. That costs compile time and
+    // memory, and it hits -ftemplate-depth (900 by default) for long packs. Here every operation is one pack
+    // expansion:
+    //   - predicates are expanded into a constexpr bool array
+    //   - a constexpr function computes the resulting indices
+    //   - the result is picked back out of the pack with at_t
+    // std::make_index_sequence is a builtin in GCC and clang (__integer_pack / __make_integer_seq).
+    //
+    //   at_t<L, I>               I-th type
+    //   find_v<L, T>             index of the first T, L::size if there is none
+    //   contains_v<L, T>
+    //   filter_t<L, Pred>        types with Pred<T>::value, in order
+    //   transform_t<L, F>        list<F<T>...>
+    //   unique_t<L>              first occurrence of every type, in order
+    //   sort_by_size_t<L>        stable sort by sizeof
+    //   concat_t<L...>
+
+    template <typename... Ts>
+    struct list
+    {
+        static constexpr std::size_t size = sizeof...(Ts);
+    };
+
+    template <typename... A, typename... B>
+    constexpr list<A..., B...>
+    operator+(list<A...>, list<B...>)
+    {
+        return {};
+    }
+
+    namespace detail
+    {
+#if TYPE_LISTS_PACK_ELEMENT
+        template <std::size_t I, typename... Ts>
+        using pack_element = __type_pack_element<I, Ts...>;
+#else
+        template <std::size_t I, typename T>
+        struct indexed
+        {
+            using type = T;
+        };
+
+        template <typename Sequence, typename... Ts>
+        struct indexer;
+
+        template <std::size_t... Is, typename... Ts>
+        struct indexer<std::index_sequence<Is...>, Ts...> : indexed<Is, Ts>...
+        {
+        };
+
+        // only used in decltype: deduction picks the one base with index I
+        template <std::size_t I, typename T>
+        indexed<I, T>
+        select(const indexed<I, T> &);
+
+        template <std::size_t I, typename... Ts>
+        using pack_element =
+            typename decltype(select<I>(indexer<std::index_sequence_for<Ts...>, Ts...>{}))::type;
+#endif
+
+        template <typename T, typename... Ts>
+        constexpr std::size_t
+        first_index()
+        {
+            constexpr bool same[] = {TYPE_LISTS_IS_SAME(T, Ts)..., false};
+            for (std::size_t i = 0; i < sizeof...(Ts); i++)
+            {
+                if (same[i])
+                {
+                    return i;
+                }
+            }
+            return sizeof...(Ts);
+        }
+
+        // positions of the `true`s
+        template <bool... Keep>
+        constexpr auto
+        kept_indices()
+        {
+            constexpr bool        keep[] = {Keep..., false};
+            constexpr std::size_t n      = (std::size_t(Keep) + ... + 0);
+
+            std::array<std::size_t, n> out{};
+            std::size_t                j = 0;
+            for (std::size_t i = 0; i < sizeof...(Keep); i++)
+            {
+                if (keep[i])
+                {
+                    out[j++] = i;
+                }
+            }
+            return out;
+        }
+
+        // stable insertion sort of the positions by key
+        template <std::size_t N>
+        constexpr std::array<std::size_t, N>
+        stable_order(const std::array<std::size_t, N> &key)
+        {
+            std::array<std::size_t, N> order{};
+            for (std::size_t i = 0; i < N; i++)
+            {
+                std::size_t j = i;
+                for (; j > 0 && key[order[j - 1]] > key[i]; j--)
+                {
+                    order[j] = order[j - 1];
+                }
+                order[j] = i;
+            }
+            return order;
+        }
+
+        // list<Ts[Indices[0]], Ts[Indices[1]], ...>
+        template <typename List, auto Indices, typename Sequence = std::make_index_sequence<Indices.size()>>
+        struct pick;
+
+        template <typename... Ts, auto Indices, std::size_t... Js>
+        struct pick<list<Ts...>, Indices, std::index_sequence<Js...>>
+        {
+            using type = list<pack_element<Indices[Js], Ts...>...>;
+        };
+
+        template <typename List, std::size_t I>
+        struct at;
+
+        template <typename... Ts, std::size_t I>
+        struct at<list<Ts...>, I>
+        {
+            static_assert(I < sizeof...(Ts), "type_lists::at_t: index out of range");
+            using type = pack_element<I, Ts...>;
+        };
+
+        template <typename List, typename T>
+        struct find;
+
+        template <typename... Ts, typename T>
+        struct find<list<Ts...>, T>
+        {
+            static constexpr std::size_t value = first_index<T, Ts...>();
+        };
+
+        template <typename List, template <typename> class Pred>
+        struct filter;
+
+        template <typename... Ts, template <typename> class Pred>
+        struct filter<list<Ts...>, Pred>
+        {
+            using type = typename pick<list<Ts...>, kept_indices<bool(Pred<Ts>::value)...>()>::type;
+        };
+
+        template <typename List, template <typename> class F>
+        struct transform;
+
+        template <typename... Ts, template <typename> class F>
+        struct transform<list<Ts...>, F>
+        {
+            using type = list<F<Ts>...>;
+        };
+
+        template <typename List, typename Sequence>
+        struct unique;
+
+        template <typename... Ts, std::size_t... Is>
+        struct unique<list<Ts...>, std::index_sequence<Is...>>
+        {
+            using type = typename pick<list<Ts...>, kept_indices<(first_index<Ts, Ts...>() == Is)...>()>::type;
+        };
+
+        template <typename List>
+        struct sort_by_size;
+
+        template <typename... Ts>
+        struct sort_by_size<list<Ts...>>
+        {
+            static constexpr std::array<std::size_t, sizeof...(Ts)> sizes = {sizeof(Ts)...};
+
+            using type = typename pick<list<Ts...>, stable_order(sizes)>::type;
+        };
+
+    } // namespace detail
+
+    template <typename List, std::size_t I>
+    using at_t = typename detail::at<List, I>::type;
+
+    template <typename List, typename T>
+    constexpr std::size_t find_v = detail::find<List, T>::value;
+
+    template <typename List, typename T>
+    constexpr bool contains_v = find_v<List, T> != List::size;
+
+    template <typename List, template <typename> class Pred>
+    using filter_t = typename detail::filter<List, Pred>::type;
+
+    template <typename List, template <typename> class F>
+    using transform_t = typename detail::transform<List, F>::type;
+
+    template <typename List>
+    using unique_t = typename detail::unique<List, std::make_index_sequence<List::size>>::type;
+
+    template <typename List>
+    using sort_by_size_t = typename detail::sort_by_size<List>::type;
+
+    template <typename... Lists>
+    using concat_t = decltype((list<>{} + ... + Lists{}));
+
+} // namespace type_lists